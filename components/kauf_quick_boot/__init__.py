@@ -0,0 +1,49 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import light
+from esphome.const import (
+    CONF_ID,
+    CONF_LIGHT_ID,
+    CONF_PASSWORD,
+    CONF_SSID,
+)
+
+DEPENDENCIES = ["light", "wifi"]
+
+kauf_quick_boot_ns = cg.esphome_ns.namespace("kauf_quick_boot")
+KaufQuickBoot = kauf_quick_boot_ns.class_("KaufQuickBoot", cg.Component)
+
+CONF_REBOOT_COUNT = "reboot_count"
+CONF_INDICATE_COUNT = "indicate_count"
+
+
+def validate_counts(value):
+    if value[CONF_INDICATE_COUNT] >= value[CONF_REBOOT_COUNT]:
+        raise cv.Invalid("indicate_count must be less than reboot_count.")
+    return value
+
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(KaufQuickBoot),
+            cv.Required(CONF_LIGHT_ID): cv.use_id(light.LightState),
+            cv.Optional(CONF_REBOOT_COUNT, default=9): cv.int_range(min=2, max=255),
+            cv.Optional(CONF_INDICATE_COUNT, default=3): cv.int_range(min=0, max=254),
+            cv.Optional(CONF_SSID, default="initial_ap"): cv.ssid,
+            cv.Optional(CONF_PASSWORD, default="asdfasdfasdfasdf"): cv.string_strict,
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    validate_counts,
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    ls = await cg.get_variable(config[CONF_LIGHT_ID])
+    cg.add(var.set_light(ls))
+    cg.add(var.set_reboot_count(config[CONF_REBOOT_COUNT]))
+    cg.add(var.set_indicate_count(config[CONF_INDICATE_COUNT]))
+    cg.add(var.set_credentials(config[CONF_SSID], config[CONF_PASSWORD]))
@@ -0,0 +1,128 @@
+#include <cinttypes>
+#include "kauf_quick_boot.h"
+#include "esphome/core/log.h"
+#include "esphome/core/hal.h"
+#include "esphome/components/wifi/wifi_component.h"
+#ifdef USE_ESP8266
+#include <user_interface.h>
+#endif
+
+namespace esphome::kauf_quick_boot {
+
+static const char *TAG = "kauf_quick_boot";
+
+static const uint32_t QUICK_BOOT_HASH = 0x4B514243UL;
+
+static const uint32_t RESET_DELAY_MS = 2000;
+static const uint32_t RESTORE_DELAY_MS = 3000;
+static const uint32_t CONNECT_DELAY_MS = 10000;
+
+void KaufQuickBoot::setup() {
+  this->rtc_ = global_preferences->make_preference<uint32_t>(QUICK_BOOT_HASH, false);
+  this->flash_ = global_preferences->make_preference<uint32_t>(QUICK_BOOT_HASH);
+
+  // only power cycles count.  a warm reset (software restart, OTA, watchdog, exception) keeps the count of the
+  // session that already counted its boot, from RTC memory or flash, but still clears it once this session makes
+  // it onto wifi.  RTC memory is garbage after power-on, so it isn't even looked at then.
+#ifdef USE_ESP8266
+  const bool warm_reset = system_get_rst_info()->reason != REASON_DEFAULT_RST;
+#else
+  const bool warm_reset = this->rtc_.load(&this->count_);
+#endif
+  if (warm_reset) {
+    if (!this->rtc_.load(&this->count_) && !this->flash_.load(&this->count_)) this->count_ = 0;
+    ESP_LOGD(TAG, "Warm reset, quick boot count stays at %" PRIu32, this->count_);
+    this->step_ = (this->count_ == 0) ? STEP_DONE : STEP_WAIT_WIFI;
+    this->step_start_ = millis();
+    return;
+  }
+
+  if (!this->flash_.load(&this->count_)) this->count_ = 0;
+  this->step_start_ = millis();
+
+  if (this->count_ >= this->reboot_count_) {
+    ESP_LOGD(TAG, "Quick boot count is now %" PRIu32 ", overwriting credentials", this->count_);
+    this->indicate_(1.0f, 0.0f, 0.0f, 0.6f);
+    this->set_count_(0);
+    this->step_ = STEP_RESET_DELAY;
+  } else {
+    this->step_ = STEP_COUNT;
+  }
+}
+
+void KaufQuickBoot::loop() {
+  const uint32_t now = millis();
+
+  switch (this->step_) {
+    case STEP_RESET_DELAY:
+      if (now - this->step_start_ < RESET_DELAY_MS) return;
+      this->step_ = STEP_RESET_WIFI;
+      // fall through
+
+    case STEP_RESET_WIFI:
+      // wait until attempt to load credentials has been made, that way we know the new ones can be saved properly.
+      if (!wifi::global_wifi_component->is_in_loop_state()) return;
+      wifi::global_wifi_component->save_wifi_sta(this->ssid_, this->password_);
+      this->step_ = STEP_COUNT;
+      // fall through
+
+    case STEP_COUNT:
+      this->set_count_(this->count_ + 1);
+      ESP_LOGD(TAG, "Quick boot count is now %" PRIu32 ".  Need %u to overwrite credentials", this->count_, this->reboot_count_);
+
+      // don't flash on the first few in case it's an accident
+      if (this->count_ > this->indicate_count_) this->indicate_(1.0f, 1.0f, 0.0f, 0.5f);
+      this->step_ = STEP_RESTORE;
+      return;
+
+    case STEP_RESTORE:
+      if (now - this->step_start_ < RESTORE_DELAY_MS) return;
+      this->light_->restore_with_mode(250);
+      this->step_ = STEP_WAIT_WIFI;
+      return;
+
+    case STEP_WAIT_WIFI:
+      if (now - this->step_start_ < CONNECT_DELAY_MS) return;
+      if (!wifi::global_wifi_component->is_connected()) return;
+      ESP_LOGD(TAG, "Up 10 seconds and connected to wifi, clearing quick boot count");
+      this->set_count_(0);
+      this->step_ = STEP_DONE;
+      // fall through
+
+    case STEP_DONE:
+      this->disable_loop();
+      return;
+  }
+}
+
+void KaufQuickBoot::clear() {
+  this->set_count_(0);
+  this->step_ = STEP_DONE;
+  this->enable_loop();
+}
+
+void KaufQuickBoot::set_count_(uint32_t count) {
+  this->count_ = count;
+  this->rtc_.save(&this->count_);
+
+  // sync() only erases and writes flash when the stored value actually changed.
+  this->flash_.save(&this->count_);
+  global_preferences->sync();
+}
+
+void KaufQuickBoot::indicate_(float red, float green, float blue, float brightness) {
+  auto call = this->light_->turn_on();
+  call.set_brightness(brightness);
+  call.set_rgb(red, green, blue);
+  call.set_save(false);
+  call.perform();
+}
+
+void KaufQuickBoot::dump_config() {
+  ESP_LOGCONFIG(TAG, "Kauf Quick Boot:");
+  ESP_LOGCONFIG(TAG, "  Reboot Count: %u", this->reboot_count_);
+  ESP_LOGCONFIG(TAG, "  Indicate Count: %u", this->indicate_count_);
+  ESP_LOGCONFIG(TAG, "  Current Count: %" PRIu32, this->count_);
+}
+
+} // namespace esphome::kauf_quick_boot
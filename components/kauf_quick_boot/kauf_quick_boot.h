@@ -0,0 +1,62 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/preferences.h"
+#include "esphome/components/light/light_state.h"
+
+namespace esphome::kauf_quick_boot {
+
+// Counts boots that don't make it 10 seconds and onto WiFi.  Once the count reaches reboot_count the
+// WiFi credentials are overwritten so the bulb comes back up in AP mode.
+//
+// The count lives in RTC memory for the running session, so warm resets (OTA, restart button, watchdog)
+// neither count as a quick boot nor touch flash.  Flash is only read when RTC memory is invalid, which on
+// this hardware means the power was actually cut, and is only written when the stored count changes.
+class KaufQuickBoot : public Component {
+ public:
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+  void set_light(light::LightState *light) { light_ = light; }
+  void set_reboot_count(uint8_t reboot_count) { reboot_count_ = reboot_count; }
+  void set_indicate_count(uint8_t indicate_count) { indicate_count_ = indicate_count; }
+  void set_credentials(const char *ssid, const char *password) {
+    ssid_ = ssid;
+    password_ = password;
+  }
+
+  uint32_t get_count() const { return count_; }
+
+  // reset the counter to 0 and stop the boot sequence (used by factory test).
+  void clear();
+
+ protected:
+  enum QuickBootStep : uint8_t {
+    STEP_RESET_DELAY,   // credentials are being reset, give wifi 2 seconds
+    STEP_RESET_WIFI,    // wait for wifi to load credentials, then overwrite them
+    STEP_COUNT,         // increment counter
+    STEP_RESTORE,       // 3 seconds in, restore light from any indication colors
+    STEP_WAIT_WIFI,     // 10 seconds in, wait for wifi to connect
+    STEP_DONE,
+  };
+
+  void set_count_(uint32_t count);
+  void indicate_(float red, float green, float blue, float brightness);
+
+  light::LightState *light_{nullptr};
+  const char *ssid_{nullptr};
+  const char *password_{nullptr};
+  uint8_t reboot_count_{9};
+  uint8_t indicate_count_{3};
+
+  ESPPreferenceObject rtc_;
+  ESPPreferenceObject flash_;
+  uint32_t count_{0};
+
+  QuickBootStep step_{STEP_COUNT};
+  uint32_t step_start_{0};
+};
+
+} // namespace esphome::kauf_quick_boot
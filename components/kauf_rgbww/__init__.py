@@ -0,0 +1,20 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+
+CONF_COMPACT_COLOR_VALUES = "compact_color_values"
+
+# optional top level block for settings that apply to every light in the build, not one light:
+#
+# kauf_rgbww:
+#   compact_color_values: true
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_COMPACT_COLOR_VALUES, default=False): cv.boolean,
+    }
+)
+
+
+async def to_code(config):
+    # uint16 storage for LightColorValues, see light_color_values.h.  It's one type for the light component.
+    if config[CONF_COMPACT_COLOR_VALUES]:
+        cg.add_define("USE_LIGHT_COMPACT_VALUES")
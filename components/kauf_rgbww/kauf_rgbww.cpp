@@ -1,13 +1,28 @@
 #include "esphome/core/log.h"
+#include "esphome/core/hal.h"
 #include "kauf_rgbww.h"
 #ifdef KAUF_ESP8266_PHASE_LOCKED_PWM
 #include "esphome/components/esp8266_pwm/esp8266_pwm.h"
 #endif
+#ifdef KAUF_OUTPUT_HANDOFF
+#include <user_interface.h>
+#endif
 
 namespace esphome::kauf_rgbww {
 
 static const char *TAG = "kauf_rgbww.light";
 
+#ifdef KAUF_OUTPUT_HANDOFF
+// RTC preference key for the output handoff.  Fixed so it doesn't move with the light name.
+static const uint32_t OUTPUT_HANDOFF_HASH = 0x4B4F4846UL;
+#endif
+
+#ifdef KAUF_TIMED_TRANSITIONS
+// timed transition cadence, and the longest transition it takes (micros() based progress has to fit 32 bits)
+static const uint32_t TIMED_INTERVAL_MS = 8;
+static const uint32_t TIMED_MAX_LENGTH_MS = 3600000UL;
+#endif
+
 // Tasmota fast gamma curve used only during active transitions.
 // input < 0        :: output = 0
 // input   0 -  384 :: output   0 -  192
@@ -24,6 +39,21 @@ static constexpr float TASMOTA_GAMMA_SLOPE2 =
 static constexpr float TASMOTA_GAMMA_SLOPE3 =
     (1.0f - TASMOTA_GAMMA_O2) / (1.0f - TASMOTA_GAMMA_I2);
 
+#ifdef KAUF_PWM_MIN_VISIBLE
+// Lowest visible level of each channel as a fraction, from its step count (light.py), so channels on
+// different frequencies get the same floor in PWM steps.  Folded at compile time.
+static constexpr float PWM_FLOOR_RED   = float(KAUF_PWM_MIN_VISIBLE_RED)   / float(KAUF_PWM_STEPS_RED);
+static constexpr float PWM_FLOOR_GREEN = float(KAUF_PWM_MIN_VISIBLE_GREEN) / float(KAUF_PWM_STEPS_GREEN);
+static constexpr float PWM_FLOOR_BLUE  = float(KAUF_PWM_MIN_VISIBLE_BLUE)  / float(KAUF_PWM_STEPS_BLUE);
+static constexpr float PWM_FLOOR_COLD  = float(KAUF_PWM_MIN_VISIBLE_COLD)  / float(KAUF_PWM_STEPS_COLD);
+static constexpr float PWM_FLOOR_WARM  = float(KAUF_PWM_MIN_VISIBLE_WARM)  / float(KAUF_PWM_STEPS_WARM);
+
+// raise non-zero levels below the floor up to it, zero stays off
+static inline float apply_pwm_floor(float level, float floor) {
+    return (level > 0.0f && level < floor) ? floor : level;
+}
+#endif
+
 static inline float apply_tasmota_gamma(float x) {
     if (x >= 0.0f && x <= TASMOTA_GAMMA_I1) {
         return x * TASMOTA_GAMMA_SLOPE1;
@@ -55,107 +85,540 @@ light::LightTraits KaufRGBWWLight::get_traits() {
 }
 
 void KaufRGBWWLight::setup_state(light::LightState *state) {
+#if defined(KAUF_PWM_DITHER) || defined(KAUF_TIMED_TRANSITIONS)
+    if ( !this->is_aux() ) this->state_ = state;
+#endif
+#ifdef KAUF_PWM_DITHER
+    if ( !this->is_aux() ) this->setup_dither_();
+#endif
+#ifdef KAUF_OUTPUT_HANDOFF
+    if ( this->is_aux() ) return;
+
+    this->handoff_rtc_ = global_preferences->make_preference<OutputHandoff>(OUTPUT_HANDOFF_HASH, false);
+
+    // RTC memory only survives warm resets (software restart, OTA, watchdog, exception).
+    // On power-on the contents are garbage and the CRC would fail anyway, but don't even look.
+    if ( system_get_rst_info()->reason == REASON_DEFAULT_RST ) return;
+    if ( !this->handoff_rtc_.load(&this->handoff_) ) return;
+
+    // setup_state() runs first thing in LightState::setup(), right after the PWM outputs are set up,
+    // so the bulb keeps its pre-reset levels instead of blinking off until restore and WiFi catch up.
+    this->red_->set_level(this->handoff_.red);
+    this->green_->set_level(this->handoff_.green);
+    this->blue_->set_level(this->handoff_.blue);
+    this->cold_white_->set_level(this->handoff_.cold);
+    this->warm_white_->set_level(this->handoff_.warm);
+    this->handoff_applied_ = true;  // LightState::setup() skips its restore write
+
+    ESP_LOGD(TAG, "Warm reset, re-applied levels - R:%f G:%f B:%f CW:%f WW:%f",
+             this->handoff_.red, this->handoff_.green, this->handoff_.blue, this->handoff_.cold, this->handoff_.warm);
+#endif
 }
 
+#ifdef KAUF_OUTPUT_HANDOFF
+void KaufRGBWWLight::mirror_outputs_(float red, float green, float blue, float cold, float warm) {
+    if ( red == this->handoff_.red && green == this->handoff_.green && blue == this->handoff_.blue
+         && cold == this->handoff_.cold && warm == this->handoff_.warm ) return;
+
+    this->handoff_ = OutputHandoff{red, green, blue, cold, warm};
+    this->handoff_rtc_.save(&this->handoff_);
+}
+#endif
+
 #ifdef KAUF_ESP8266_PHASE_LOCKED_PWM
 void KaufRGBWWLight::set_warm_white_pwm(output::FloatOutput *pwm) {
   warm_white_pwm_ = static_cast<esphome::esp8266_pwm::ESP8266PWM *>(pwm);
 }
 #endif
 
-void KaufRGBWWLight::write_state(light::LightState *state) {
+void KaufRGBWWLight::set_warm_white_level_(light::LightState *state, float level) {
+#ifdef KAUF_ESP8266_PHASE_LOCKED_PWM
+    // this block is notifying the warm white output of what phase it needs to turn on to so that it doesn't overlap cold white
+    float last_ww = warm_white_pwm_ ? warm_white_pwm_->get_last_output() : 0.0f;
+    if (warm_white_pwm_ != nullptr
+        && level > 0.0f
+        && (last_ww <= 0.0f || last_ww >= 1.0f)) {
+      float remote_ct = state->remote_values.get_color_temperature();
+      if (remote_ct >= this->min_mireds && remote_ct <= this->max_mireds) {
+        const float mired_span = this->max_mireds - this->min_mireds;
+        float ct_norm = mired_span != 0.0f ? (remote_ct - this->min_mireds) / mired_span : 0.0f;
+        float phase = fmaxf(1.0f - ct_norm, 1.0f - warm_white_pwm_->get_max_power());
+        warm_white_pwm_->prepare_startup_phase(phase);
+      }
+    }
+#endif
 
-    if ( this->is_aux() ) {
+    this->warm_white_->set_level(level);
+}
 
-        // tells main light that the aux light has changed so refresh.
-        state->has_changed = true;
+void KaufRGBWWLight::write_levels_(light::LightState *state, float red, float green, float blue, float cold, float warm) {
+#ifdef KAUF_PWM_DITHER
+    if ( this->dither_ ) {
+        const float levels[5] = {red, green, blue, cold, warm};
+        bool fractional = false;
+        for (uint8_t i = 0; i < 5; i++) {
+            const DitherScale &s = this->dither_scale_[i];
+            DitherChannel &ch = this->dither_ch_[i];
+            const float q = s.to_q * (levels[i] - s.min_level);
+            const uint32_t target = q > 0.0f ? static_cast<uint32_t>(q + 0.5f) : 0;
+            const uint32_t step = target >> DITHER_BITS;
+            ch.fraction = target & DITHER_MASK;
+            ch.low = step == 0 ? 0.0f : step * s.from_step + s.min_level;
+            ch.high = (step + 1) * s.from_step + s.min_level;
+            fractional |= ch.fraction != 0;
+        }
+        this->write_dithered_(state);
+        // only levels between steps need the loop, whole steps are already exact
+        if ( fractional ) {
+            this->dither_steps_ = 0;
+            this->dither_last_us_ = micros();
+            this->dither_high_freq_.start();
+            this->enable_loop();
+        } else {
+            this->stop_dither_();
+        }
+        return;
+    }
+#endif
+    this->red_->set_level(red);
+    this->green_->set_level(green);
+    this->blue_->set_level(blue);
+    this->cold_white_->set_level(cold);
+    this->set_warm_white_level_(state, warm);
+}
 
-        // enable main light's loop so it can check the has_changed flag
-        if (this->main_light != nullptr) {
-            this->main_light->enable_loop();
+#ifdef KAUF_PWM_DITHER
+void KaufRGBWWLight::setup_dither_() {
+    output::FloatOutput *outputs[5] = {this->red_, this->green_, this->blue_, this->cold_white_, this->warm_white_};
+    const uint32_t steps[5] = {KAUF_PWM_STEPS_RED, KAUF_PWM_STEPS_GREEN, KAUF_PWM_STEPS_BLUE,
+                               KAUF_PWM_STEPS_COLD, KAUF_PWM_STEPS_WARM};
+    for (uint8_t i = 0; i < 5; i++) {
+        DitherScale &s = this->dither_scale_[i];
+        // FloatOutput maps level to duty as min_power + level * (max_power - min_power)
+        const float span = outputs[i]->get_max_power() - outputs[i]->get_min_power();
+        s.to_q = span * steps[i] * float(1u << DITHER_BITS);
+        s.from_step = span > 0.0f ? 1.0f / (span * steps[i]) : 0.0f;
+        s.min_level = span > 0.0f ? -outputs[i]->get_min_power() / span : 0.0f;
+    }
+}
+
+float KaufRGBWWLight::dither_step_(DitherChannel &ch) {
+    const uint8_t acc = ch.fraction + ch.residue;
+    ch.residue = acc & DITHER_MASK;
+    return (acc >> DITHER_BITS) != 0 ? ch.high : ch.low;
+}
+
+void KaufRGBWWLight::write_dithered_(light::LightState *state) {
+    this->red_->set_level(this->dither_step_(this->dither_ch_[0]));
+    this->green_->set_level(this->dither_step_(this->dither_ch_[1]));
+    this->blue_->set_level(this->dither_step_(this->dither_ch_[2]));
+    this->cold_white_->set_level(this->dither_step_(this->dither_ch_[3]));
+    this->set_warm_white_level_(state, this->dither_step_(this->dither_ch_[4]));
+}
+
+// A pattern has to repeat well above flicker fusion, which the default 16 ms loop doesn't, so while dithering the
+// loop runs at high frequency and steps on a fixed DITHER_INTERVAL_US cadence.  Transitions write a new level every
+// loop and keep it going, a level that stays put gets DITHER_MAX_STEPS intervals and then the nearest whole step.
+void KaufRGBWWLight::loop() {
+    if ( !this->dither_ || this->state_ == nullptr ) {
+        this->stop_dither_();
+        return;
+    }
+
+    const uint32_t now = micros();
+    if ( now - this->dither_last_us_ < DITHER_INTERVAL_US ) return;
+    this->dither_last_us_ = now;
+
+    if ( ++this->dither_steps_ >= DITHER_MAX_STEPS ) {
+        for (auto &ch : this->dither_ch_) {
+            if ( ch.fraction > DITHER_MASK / 2 ) ch.low = ch.high;
+            ch.fraction = 0;
+            ch.residue = 0;
+        }
+        this->write_dithered_(this->state_);
+        this->stop_dither_();
+        return;
+    }
+
+    this->write_dithered_(this->state_);
+}
+
+void KaufRGBWWLight::stop_dither_() {
+    this->disable_loop();
+    this->dither_high_freq_.stop();
+}
+#endif
+
+#ifdef KAUF_HAS_AUX
+const KaufRGBWWLight::AuxContribution &KaufRGBWWLight::aux_contribution_(light::LightState *aux,
+                                                                        AuxContribution &cached) {
+    // gamma runs four times per aux light, only redo it when the aux light has written new values
+    const uint32_t generation = aux != nullptr ? aux->get_current_values_generation() : 0;
+    if ( generation != cached.generation || generation == 0 ) {
+        cached.generation = generation;
+        cached.on = aux != nullptr && aux->current_values.is_on();
+        if ( cached.on ) {
+            aux->current_values_as_rgbw(&cached.red, &cached.green, &cached.blue, &cached.white);
+        } else {
+            // adds no color and leaves the white channel alone, same as the mix without this aux light
+            cached.red = cached.green = cached.blue = 0.0f;
+            cached.white = 1.0f;
+        }
+    }
+    return cached;
+}
+#endif
+
+#ifdef KAUF_TIMED_TRANSITIONS
+bool KaufRGBWWLight::start_timed_transition(light::LightState *state, light::LightTransformer *transformer,
+                                            uint32_t length) {
+    this->stop_timed_transition();
+    if ( this->is_aux() || this->state_ == nullptr || length == 0 || length > TIMED_MAX_LENGTH_MS ) return false;
+#ifdef KAUF_PWM_DITHER
+    // dithering writes the outputs from loop() itself
+    if ( this->dither_ ) return false;
+#endif
+
+    this->timed_transformer_ = transformer;
+    if ( !this->sample_timed_transition_() ) {
+        // flash, ramp or another transformer that can't be sampled ahead
+        this->timed_transformer_ = nullptr;
+        return false;
+    }
+
+    this->timed_start_us_ = micros();
+    this->timed_length_us_ = length * 1000UL;
+    this->timed_last_us_ = 0;
+    this->timed_intervals_ = 0;
+    this->timed_mean_ = 0.0f;
+    this->timed_m2_ = 0.0f;
+#ifdef USE_LIGHT_SCENES
+    this->levels_settled_ = false;
+#endif
+
+    this->step_timed_transition_();
+    this->arm_timed_timer_();
+    return true;
+}
+
+void KaufRGBWWLight::stop_timed_transition() {
+    if ( this->timed_transformer_ == nullptr ) return;
+    {
+        // on ESP32 a step may be running in the timer task, let it finish so it can't land after the loop's write
+        LockGuard guard(this->timed_lock_);
+        this->disarm_timed_timer_();
+        this->timed_transformer_ = nullptr;
+    }
+
+    if ( this->timed_intervals_ > 1 ) {
+        ESP_LOGD(TAG, "Timed transition: %u frames, interval %.0f us, jitter (stddev) %.0f us",
+                 (unsigned) this->timed_intervals_ + 1, this->timed_mean_,
+                 sqrtf(this->timed_m2_ / float(this->timed_intervals_ - 1)));
+    }
+}
+
+bool KaufRGBWWLight::sample_timed_transition_() {
+    TimedFrames &frames = this->timed_frames_.edit();
+    bool aux = false;
+#ifdef KAUF_HAS_AUX
+    aux = this->aux_contribution_(warm_rgb, this->warm_aux_).on;
+    aux = this->aux_contribution_(cold_rgb, this->cold_aux_).on || aux;
+#endif
+
+    light::LightColorValues values;
+    float in[5];
+    for (uint8_t i = 0; i <= TIMED_FRAMES; i++) {
+        if ( !this->timed_transformer_->sample(float(i) / float(TIMED_FRAMES), values) ) return false;
+        this->transition_inputs_(values, in);
+        this->mix_levels_(in, frames.levels[i], aux);
+    }
+
+    // same color temperature a loop rendered transition leaves for white blending afterwards
+    ct = in[4];
+
+    // the timer picks these frames up on its next step
+    this->timed_frames_.publish();
+    return true;
+}
+
+void KaufRGBWWLight::step_timed_transition_() {
+    const uint32_t now = micros();
+    if ( this->timed_last_us_ != 0 ) {
+        const float interval = float(now - this->timed_last_us_);
+        this->timed_intervals_++;
+        const float delta = interval - this->timed_mean_;
+        this->timed_mean_ += delta / float(this->timed_intervals_);
+        this->timed_m2_ += delta * (interval - this->timed_mean_);
+    }
+
+    TimedFrames snapshot;
+    if ( !this->timed_frames_.read(snapshot) ) return;  // being sampled again right now, next step has them
+    const float (*frames)[5] = snapshot.levels;
+    const uint32_t elapsed = now - this->timed_start_us_;
+    float levels[5];
+    if ( elapsed >= this->timed_length_us_ ) {
+        // last frame, loop() lands on the exact target once the transformer finishes
+        for (uint8_t c = 0; c < 5; c++) levels[c] = frames[TIMED_FRAMES][c];
+        this->disarm_timed_timer_();
+        this->timed_last_us_ = 0;
+    } else {
+        const float pos = float(elapsed) / float(this->timed_length_us_) * float(TIMED_FRAMES);
+        const uint8_t i = static_cast<uint8_t>(pos);
+        const float f = pos - float(i);
+        for (uint8_t c = 0; c < 5; c++) levels[c] = frames[i][c] + (frames[i + 1][c] - frames[i][c]) * f;
+        this->timed_last_us_ = now;
+    }
+
+    this->write_levels_(this->state_, levels[0], levels[1], levels[2], levels[3], levels[4]);
+}
+
+void KaufRGBWWLight::arm_timed_timer_() {
+#ifdef USE_ESP8266
+    os_timer_disarm(&this->timed_timer_);
+    os_timer_setfn(&this->timed_timer_, &KaufRGBWWLight::timed_tick_, this);
+    os_timer_arm(&this->timed_timer_, TIMED_INTERVAL_MS, true);
+#endif
+#ifdef USE_ESP32
+    if ( this->timed_timer_ == nullptr ) {
+        esp_timer_create_args_t args{};
+        args.callback = &KaufRGBWWLight::timed_tick_;
+        args.arg = this;
+        args.name = "kauf_timed";
+        if ( esp_timer_create(&args, &this->timed_timer_) != ESP_OK ) {
+            ESP_LOGE(TAG, "Creating the transition timer failed");
+            this->timed_timer_ = nullptr;
+            return;
         }
+    }
+    esp_timer_start_periodic(this->timed_timer_, TIMED_INTERVAL_MS * 1000ULL);
+#endif
+}
+
+void KaufRGBWWLight::disarm_timed_timer_() {
+#ifdef USE_ESP8266
+    os_timer_disarm(&this->timed_timer_);
+#endif
+#ifdef USE_ESP32
+    // not running is fine, it may have stopped itself on the last frame
+    if ( this->timed_timer_ != nullptr ) esp_timer_stop(this->timed_timer_);
+#endif
+}
+
+void KaufRGBWWLight::timed_tick_(void *arg) {
+    auto *light = static_cast<KaufRGBWWLight *>(arg);
+    LockGuard guard(light->timed_lock_);
+    if ( light->timed_transformer_ != nullptr ) light->step_timed_transition_();
+}
+#endif
+
+#ifdef USE_LIGHT_SCENES
+bool KaufRGBWWLight::aux_on_() {
+#ifdef KAUF_HAS_AUX
+    return (warm_rgb != nullptr && warm_rgb->current_values.is_on()) ||
+           (cold_rgb != nullptr && cold_rgb->current_values.is_on());
+#else
+    return false;
+#endif
+}
 
-        ESP_LOGV("KAUF RGBWW","set has_changed to true");
+bool KaufRGBWWLight::capture_levels(light::LightState *state, float *levels) {
+    if ( this->is_aux() || !this->levels_settled_ || this->aux_on_() ) return false;
+    for (uint8_t i = 0; i < light::LIGHT_SCENE_LEVELS; i++) levels[i] = this->levels_[i];
+    return true;
+}
+
+bool KaufRGBWWLight::apply_levels(light::LightState *state, const float *levels) {
+    if ( this->is_aux() || this->aux_on_() ) return false;
+
+    // keep the color temperature write_state() blends RGB whites with in step with the recalled values
+    float white_brightness;
+    if ( state->current_values.get_color_mode() & light::ColorCapability::COLOR_TEMPERATURE ) {
+        state->current_values.as_ct(min_mireds, max_mireds, &ct, &white_brightness);
+    }
+
+    this->write_levels_(state, levels[0], levels[1], levels[2], levels[3], levels[4]);
+
+    for (uint8_t i = 0; i < light::LIGHT_SCENE_LEVELS; i++) this->levels_[i] = levels[i];
+    this->levels_settled_ = true;
+#ifdef KAUF_OUTPUT_HANDOFF
+    this->mirror_outputs_(levels[0], levels[1], levels[2], levels[3], levels[4]);
+#endif
+
+    ESP_LOGV("Kauf Light", "Replayed Levels - R:%f G:%f B:%f CW:%f WW:%f)", levels[0], levels[1], levels[2], levels[3], levels[4]);
+    return true;
+}
+#endif
+
+void KaufRGBWWLight::write_state(light::LightState *state) {
+
+    if ( this->is_aux() ) {
 
         // Ignore straight brightness (always reset to max).
         // We just rely on separate color and white brightness sliders.
         state->current_values.set_brightness(1.0f);
 
+#ifdef KAUF_HAS_AUX
+        // tells main light that the aux light has changed so refresh.
+        if (this->main_light != nullptr) {
+            this->main_light->schedule_aux_write();
+        }
+
+        ESP_LOGV("KAUF RGBWW","aux changed, main light scheduled");
+#endif
+
         return;
     }
 
-    float red, green, blue;
-    float white_brightness;
-    const float mired_span = max_mireds - min_mireds;
-    const float inv_mired_span = mired_span != 0.0f ? (1.0f / mired_span) : 0.0f;
+#ifdef KAUF_TIMED_TRANSITIONS
+    // LightState doesn't write the frames of a timed transition, so this is an aux light changing: sample the
+    // frames again with it.  DDP frames take the outputs back.
+    if ( this->timed_transformer_ != nullptr ) {
+        if ( !state->current_values.use_raw && this->sample_timed_transition_() ) return;
+        this->stop_timed_transition();
+    }
+#endif
+
+#ifdef KAUF_HAS_AUX
+    const uint32_t generation = state->get_current_values_generation();
+    const uint32_t warm_generation = warm_rgb != nullptr ? warm_rgb->get_current_values_generation() : 0;
+    const uint32_t cold_generation = cold_rgb != nullptr ? cold_rgb->get_current_values_generation() : 0;
+
+    // nothing feeding the mix changed since the last one, the outputs already hold it
+    if ( generation == this->mix_generation_[0] && warm_generation == this->mix_generation_[1]
+         && cold_generation == this->mix_generation_[2] ) return;
 
+    this->mix_generation_[0] = generation;
+    this->mix_generation_[1] = warm_generation;
+    this->mix_generation_[2] = cold_generation;
+#endif
+
+    // light bulb is off, set all outputs to 0 and return early.
+    // use_raw is reserved for DDP/raw values, those are written even with the state off.
+    if ( !state->current_values.use_raw && !state->current_values.is_on() ) {
+
+        this->write_levels_(state, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+#ifdef USE_LIGHT_SCENES
+        for (float &level : this->levels_) level = 0.0f;
+        this->levels_settled_ = true;
+#endif
+#ifdef KAUF_OUTPUT_HANDOFF
+        this->mirror_outputs_(0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+#endif
+        return;
+
+    }
+
+#ifdef KAUF_HAS_AUX
+    bool aux = this->aux_contribution_(warm_rgb, this->warm_aux_).on;
+    aux = this->aux_contribution_(cold_rgb, this->cold_aux_).on || aux;
+#else
+    const bool aux = false;
+#endif
 
     // get rgbww values.
+    float in[5];
+#ifdef KAUF_HAS_AUX
+    // only an aux light changed, the main light inputs are the same as last mix
+    if ( generation == this->inputs_generation_ ) {
+        for (uint8_t i = 0; i < 5; i++) in[i] = this->inputs_[i];
+    } else {
+        this->read_inputs_(state, in);
+        this->inputs_generation_ = generation;
+        for (uint8_t i = 0; i < 5; i++) this->inputs_[i] = in[i];
+    }
+#else
+    this->read_inputs_(state, in);
+#endif
 
-    // use_raw is reserved for DDP/raw values; don't reshape them here.
-    if ( state->current_values.use_raw ) {
+    float levels[5];
+    this->mix_levels_(in, levels, aux);
 
-        // ESP_LOGD("Kauf Light", "Use Raw - Yes");
-        // state->current_values.use_raw = false;
+    // set outputs
+    this->write_levels_(state, levels[0], levels[1], levels[2], levels[3], levels[4]);
 
-        state->current_values.as_ct(min_mireds, max_mireds, &ct, &white_brightness);
-        red   = state->current_values.get_red();
-        green = state->current_values.get_green();
-        blue  = state->current_values.get_blue();
+    // settled means no transition and no DDP
+    [[maybe_unused]] const bool settled = !state->current_values.use_raw && !state->is_transformer_active();
+
+#ifdef USE_LIGHT_SCENES
+    for (uint8_t i = 0; i < light::LIGHT_SCENE_LEVELS; i++) this->levels_[i] = levels[i];
+    this->levels_settled_ = settled;
+#endif
 
+#ifdef KAUF_OUTPUT_HANDOFF
+    // only mirror settled levels, not every transition frame or raw DDP frame
+    if ( settled ) {
+        this->mirror_outputs_(levels[0], levels[1], levels[2], levels[3], levels[4]);
     }
+#endif
 
-    // light bulb is off, set all outputs to 0 and return early.
-    else if ( !state->current_values.is_on() ) {
+    ESP_LOGV("Kauf Light", "Set Levels - R:%f G:%f B:%f CW:%f WW:%f)", levels[0], levels[1], levels[2], levels[3], levels[4]);
 
-        this->red_->set_level(0.0f);
-        this->green_->set_level(0.0f);
-        this->blue_->set_level(0.0f);
-        this->cold_white_->set_level(0.0f);
-        this->warm_white_->set_level(0.0f);
-        return;
+}
+
+// reads the inputs of a transition frame (red, green, blue, white brightness, ct) from values.
+// Transformer output is already in linear output space, so read it directly (do not re-scale via as_rgb/as_ct).
+void KaufRGBWWLight::transition_inputs_(const light::LightColorValues &values, float *in) const {
+    const float mired_span = max_mireds - min_mireds;
+    const float inv_mired_span = mired_span != 0.0f ? (1.0f / mired_span) : 0.0f;
+    float ct_in = (values.get_color_temperature() - min_mireds) * inv_mired_span;
+    if (ct_in < 0.0f) ct_in = 0.0f;
+    if (ct_in > 1.0f) ct_in = 1.0f;
+    in[0] = apply_tasmota_gamma(values.get_red());
+    in[1] = apply_tasmota_gamma(values.get_green());
+    in[2] = apply_tasmota_gamma(values.get_blue());
+    in[3] = apply_tasmota_gamma(values.get_brightness());
+    in[4] = ct_in;
+}
+
+// reads the main light inputs (red, green, blue, white brightness, ct) after gamma, keeps ct.
+void KaufRGBWWLight::read_inputs_(light::LightState *state, float *in) {
+
+    // use_raw is reserved for DDP/raw values; don't reshape them here.
+    if ( state->current_values.use_raw ) {
+
+        state->current_values.as_ct(min_mireds, max_mireds, &ct, &in[3]);
+        in[0] = state->current_values.get_red();
+        in[1] = state->current_values.get_green();
+        in[2] = state->current_values.get_blue();
 
     }
 
     // During transitions we must evaluate RGB and CT/WB together because mode-to-mode
-    // transitions can have both contributions at once. Transformer output is already
-    // in linear output space, so read it directly (do not re-scale via as_rgb/as_ct).
-    else if (state->is_transformer_active()) {
+    // transitions can have both contributions at once.
+    else if ( state->is_transformer_active() ) {
 
-        red = state->current_values.get_red();
-        green = state->current_values.get_green();
-        blue = state->current_values.get_blue();
-        white_brightness = state->current_values.get_brightness();
-        ct = (state->current_values.get_color_temperature() - min_mireds) * inv_mired_span;
-        if (ct < 0.0f) ct = 0.0f;
-        if (ct > 1.0f) ct = 1.0f;
-        red = apply_tasmota_gamma(red);
-        green = apply_tasmota_gamma(green);
-        blue = apply_tasmota_gamma(blue);
-        white_brightness = apply_tasmota_gamma(white_brightness);
+        this->transition_inputs_(state->current_values, in);
+        ct = in[4];
 
     }
 
     // CT color mode.  all RGB zeros, get ct values.
     else if ( state->current_values.get_color_mode() & light::ColorCapability::COLOR_TEMPERATURE ) {
 
-        state->current_values_as_ct(&ct, &white_brightness);
-        red = 0.0f;
-        green = 0.0f;
-        blue = 0.0f;
+        state->current_values_as_ct(&ct, &in[3]);
+        in[0] = 0.0f;
+        in[1] = 0.0f;
+        in[2] = 0.0f;
 
     }
 
     // RGB color mode.  Get rgb values with default gamma.  No white channel in RGB mode.
     else {
 
-        state->current_values_as_rgb(&red, &green, &blue);
-        white_brightness = 0.0f;
+        state->current_values_as_rgb(&in[0], &in[1], &in[2]);
+        in[3] = 0.0f;
 
     }
 
+    in[4] = ct;
+
+}
+
+// mixes the inputs into output levels (red, green, blue, cold, warm), with the aux lights if aux.
+void KaufRGBWWLight::mix_levels_(const float *in, float *levels, [[maybe_unused]] bool aux) const {
+    const float red = in[0], green = in[1], blue = in[2], white_brightness = in[3], mix_ct = in[4];
 
-    float inv_ct = 1.0f - ct;
+    float inv_ct = 1.0f - mix_ct;
 
     // get minimum of input rgb values for blending into white
     float min_val;
@@ -165,12 +628,7 @@ void KaufRGBWWLight::write_state(light::LightState *state) {
 
 
     float scaled_red, scaled_green, scaled_blue, scaled_warm, scaled_cold;
-#ifdef KAUF_HAS_AUX
     float mw = min_val * max_white;
-    float white_blend = mw + white_brightness;
-#else
-    float white_blend = (min_val * max_white) + white_brightness;
-#endif
 
     // calculate output values:
     //   scaled RGB = color in, reduced by amount going to white blend
@@ -179,74 +637,58 @@ void KaufRGBWWLight::write_state(light::LightState *state) {
     scaled_blue  = blue  - min_val;
 
 #ifdef KAUF_HAS_AUX
-    bool warm_on = (warm_rgb != nullptr && warm_rgb->current_values.is_on());
-    bool cold_on = (cold_rgb != nullptr && cold_rgb->current_values.is_on());
-
-    //   if warm aux light is on, accumulate warm_rgb scaled to white brightness and color temp
-    if ( warm_on ) {
-        float warm_red, warm_green, warm_blue, warm_white;
-        warm_rgb->current_values_as_rgbw(&warm_red, &warm_green, &warm_blue, &warm_white);
-        float wb_warm = white_brightness * ct;
-        scaled_red   += warm_red   * wb_warm;
-        scaled_green += warm_green * wb_warm;
-        scaled_blue  += warm_blue  * wb_warm;
+    if ( aux ) {
+        // an aux light that is off or absent adds no color and has white 1.0, so both are always accumulated
+        const AuxContribution &warm = this->warm_aux_;
+        const AuxContribution &cold = this->cold_aux_;
+
+        //   accumulate warm_rgb scaled to white brightness and color temp
+        float wb_warm = white_brightness * mix_ct;
+        scaled_red   += warm.red   * wb_warm;
+        scaled_green += warm.green * wb_warm;
+        scaled_blue  += warm.blue  * wb_warm;
 
         //   scaled_warm = white blend amount (scaled with max_white since 100% white is too powerful for RGB colors)
         //               + white brightness scaled by aux warm_white (in case aux light indicates to turn down white channel)
         //               * color temp to scale for warm channel
-        scaled_warm = (mw + (white_brightness * warm_white)) * ct;
-    } else
-#endif
-    //   warm aux off or absent: white blend (includes white brightness since warm_white defaults to 1.0) * color temp
-    { scaled_warm = white_blend * ct; }
+        scaled_warm = (mw + (white_brightness * warm.white)) * mix_ct;
 
-#ifdef KAUF_HAS_AUX
-    //   if cold aux light is on, accumulate cold_rgb scaled to white brightness and color temp
-    if ( cold_on ) {
-        float cold_red, cold_green, cold_blue, cold_white;
-        cold_rgb->current_values_as_rgbw(&cold_red, &cold_green, &cold_blue, &cold_white);
+        //   accumulate cold_rgb scaled to white brightness and color temp
         float wb_cold = white_brightness * inv_ct;
-        scaled_red   += cold_red   * wb_cold;
-        scaled_green += cold_green * wb_cold;
-        scaled_blue  += cold_blue  * wb_cold;
+        scaled_red   += cold.red   * wb_cold;
+        scaled_green += cold.green * wb_cold;
+        scaled_blue  += cold.blue  * wb_cold;
 
         //   scaled_cold = white blend amount (scaled with max_white since 100% white is too powerful for RGB colors)
         //               + white brightness scaled by aux cold_white (in case aux light indicates to turn down white channel)
         //               * inverse color temp to scale for cold channel
-        scaled_cold = (mw + (white_brightness * cold_white)) * inv_ct;
+        scaled_cold = (mw + (white_brightness * cold.white)) * inv_ct;
     } else
 #endif
-    //   cold aux off or absent: white blend (includes white brightness since cold_white defaults to 1.0) * inverse color temp
-    { scaled_cold = white_blend * inv_ct; }
+    {
+        //   no aux light on: white blend (white blend amount + white brightness) * color temp / inverse color temp
+        float white_blend = mw + white_brightness;
+        scaled_warm = white_blend * mix_ct;
+        scaled_cold = white_blend * inv_ct;
+    }
 
     //   reduce blue to make RGB more accurate
     scaled_blue *= max_blue;
 
-    // set outputs
-    this->red_->set_level(scaled_red);
-    this->green_->set_level(scaled_green);
-    this->blue_->set_level(scaled_blue);
-    this->cold_white_->set_level(scaled_cold);
-
-#ifdef KAUF_ESP8266_PHASE_LOCKED_PWM
-    // this block is notifying the warm white output of what phase it needs to turn on to so that it doesn't overlap cold white
-    float last_ww = warm_white_pwm_ ? warm_white_pwm_->get_last_output() : 0.0f;
-    if (warm_white_pwm_ != nullptr
-        && scaled_warm > 0.0f
-        && (last_ww <= 0.0f || last_ww >= 1.0f)) {
-      float remote_ct = state->remote_values.get_color_temperature();
-      if (remote_ct >= this->min_mireds && remote_ct <= this->max_mireds) {
-        float ct_norm = (remote_ct - this->min_mireds) * inv_mired_span;
-        float phase = fmaxf(1.0f - ct_norm, 1.0f - warm_white_pwm_->get_max_power());
-        warm_white_pwm_->prepare_startup_phase(phase);
-      }
-    }
+#ifdef KAUF_PWM_MIN_VISIBLE
+    // keep dim channels from rounding to off
+    scaled_red   = apply_pwm_floor(scaled_red,   PWM_FLOOR_RED);
+    scaled_green = apply_pwm_floor(scaled_green, PWM_FLOOR_GREEN);
+    scaled_blue  = apply_pwm_floor(scaled_blue,  PWM_FLOOR_BLUE);
+    scaled_cold  = apply_pwm_floor(scaled_cold,  PWM_FLOOR_COLD);
+    scaled_warm  = apply_pwm_floor(scaled_warm,  PWM_FLOOR_WARM);
 #endif
 
-    this->warm_white_->set_level(scaled_warm);
-
-    ESP_LOGV("Kauf Light", "Set Levels - R:%f G:%f B:%f CW:%f WW:%f)", scaled_red, scaled_green, scaled_blue, scaled_cold, scaled_warm);
-
+    levels[0] = scaled_red;
+    levels[1] = scaled_green;
+    levels[2] = scaled_blue;
+    levels[3] = scaled_cold;
+    levels[4] = scaled_warm;
 }
 
 } //namespace esphome::kauf_rgbww
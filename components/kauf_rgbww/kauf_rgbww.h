@@ -3,6 +3,22 @@
 #include "esphome/core/component.h"
 #include "esphome/components/output/float_output.h"
 #include "esphome/components/light/light_output.h"
+#ifdef KAUF_OUTPUT_HANDOFF
+#include "esphome/core/preferences.h"
+#endif
+#ifdef KAUF_PWM_DITHER
+#include "esphome/core/helpers.h"
+#endif
+#ifdef KAUF_TIMED_TRANSITIONS
+#include "esphome/core/helpers.h"
+#include "esphome/components/light/render_state.h"
+#ifdef USE_ESP8266
+#include <user_interface.h>
+#endif
+#ifdef USE_ESP32
+#include <esp_timer.h>
+#endif
+#endif
 
 #ifdef KAUF_ESP8266_PHASE_LOCKED_PWM
 namespace esphome { namespace esp8266_pwm { class ESP8266PWM; } }
@@ -10,7 +26,7 @@ namespace esphome { namespace esp8266_pwm { class ESP8266PWM; } }
 
 namespace esphome::kauf_rgbww {
 
-class KaufRGBWWLight : public light::LightOutput, public Component {
+class KaufRGBWWLight final : public light::LightOutput, public Component {
   public:
 
   light::LightTraits get_traits() override;
@@ -28,10 +44,25 @@ class KaufRGBWWLight : public light::LightOutput, public Component {
   void set_warm_white_temperature(float warm_white_temperature) { this->max_mireds = warm_white_temperature; }
   void set_constant_brightness(bool constant_brightness) { constant_brightness_ = constant_brightness; }
   void set_color_interlock(bool color_interlock) { color_interlock_ = color_interlock; }
+#ifdef KAUF_PWM_DITHER
+  void set_dither(bool dither) { dither_ = dither; }
+  void loop() override;
+#endif
 
   void write_state(light::LightState *state) override;
+#ifdef USE_LIGHT_SCENES
+  bool capture_levels(light::LightState *state, float *levels) override;
+  bool apply_levels(light::LightState *state, const float *levels) override;
+#endif
+#ifdef KAUF_TIMED_TRANSITIONS
+  bool start_timed_transition(light::LightState *state, light::LightTransformer *transformer, uint32_t length) override;
+  void stop_timed_transition() override;
+#endif
 
   void set_outputs(float red, float green, float blue, float white_brightness = 0.0f);
+#ifdef KAUF_OUTPUT_HANDOFF
+  bool has_handoff_levels() override { return this->handoff_applied_; }
+#endif
 
 
 
@@ -59,6 +90,138 @@ class KaufRGBWWLight : public light::LightOutput, public Component {
   // that way we save most recent color temp for white blending when we switch over to RGB
   float ct = .5f;
 
+  // write_state() reads the inputs (red, green, blue, white brightness, ct) for the current source and mixes them
+  // into output levels (red, green, blue, cold, warm), adding the aux lights when one is on.
+  void transition_inputs_(const light::LightColorValues &values, float *in) const;
+  void read_inputs_(light::LightState *state, float *in);
+  void mix_levels_(const float *in, float *levels, bool aux) const;
+
+  // sets the warm white output, lining its PWM phase up behind cold white first when phase locked.
+  void set_warm_white_level_(light::LightState *state, float level);
+
+  // sets all five outputs, through the dither stage when it's on.
+  void write_levels_(light::LightState *state, float red, float green, float blue, float cold, float warm);
+
+#ifdef KAUF_PWM_DITHER
+  // first order sigma-delta per channel, in integer duty units.  A new level is split once into the whole PWM step
+  // below it and a fraction in 1/4 steps, and the output levels of that step and the next are worked out then.
+  // Every DITHER_INTERVAL_US the fraction adds into the residue and a carry writes the step above, so a level
+  // between two steps alternates between them with the right average, repeating every 4 intervals at most.
+  // DITHER_MAX_STEPS intervals after the last new level it settles on the nearest step and the loop goes idle.
+  static constexpr uint8_t DITHER_BITS = 2;
+  static constexpr uint8_t DITHER_MASK = (1u << DITHER_BITS) - 1;
+  static constexpr uint32_t DITHER_INTERVAL_US = 2000;  // 4 step pattern at 125 Hz
+  static constexpr uint16_t DITHER_MAX_STEPS = 1000;    // 2 s
+  struct DitherScale {
+    float to_q;       // level -> duty in 1/4 steps
+    float from_step;  // whole steps -> level
+    float min_level;  // level of a duty of zero steps, from min_power
+  };
+  struct DitherChannel {
+    float low;         // output level of the step below
+    float high;        // output level of the step above
+    uint8_t fraction;  // 1/4 steps above low
+    uint8_t residue;
+  };
+  DitherScale dither_scale_[5]{};
+  DitherChannel dither_ch_[5]{};
+  bool dither_{false};
+  HighFrequencyLoopRequester dither_high_freq_;
+  uint32_t dither_last_us_{0};
+  uint16_t dither_steps_{0};
+  void setup_dither_();
+  void stop_dither_();
+  float dither_step_(DitherChannel &ch);
+  void write_dithered_(light::LightState *state);
+#endif
+
+#ifdef KAUF_HAS_AUX
+  // gamma corrected rgbw of an aux light, refreshed only when its current values generation moves on.
+  // Off or absent it holds no color and white 1.0, which mixes the same as no aux light.
+  struct AuxContribution {
+    uint32_t generation;
+    bool on;
+    float red;
+    float green;
+    float blue;
+    float white;
+  };
+  AuxContribution warm_aux_{};
+  AuxContribution cold_aux_{};
+  const AuxContribution &aux_contribution_(light::LightState *aux, AuxContribution &cached);
+
+  // main light inputs (after gamma) of the last mix and the generation they were read at, so a write
+  // pushed by an aux light doesn't read them again.
+  uint32_t inputs_generation_{0};
+  float inputs_[5]{};  // red, green, blue, white brightness, ct
+
+  // generations of the main and aux lights the outputs were last mixed from
+  uint32_t mix_generation_[3]{};
+#endif
+
+#ifdef KAUF_TIMED_TRANSITIONS
+  // transition frames sampled ahead in the main loop and stepped from a timer at a fixed cadence, with progress
+  // from micros().  The loop publishes the frames through a RenderBuffer and the timer snapshots them each step.
+  // On ESP32 the timer is an esp_timer, which runs in its own task and keeps stepping while the loop is blocked.
+  // On ESP8266 timer1 belongs to the PWM waveform, so it is an os_timer: the SDK runs those between loop passes
+  // and while the loop yields or delays, not in the middle of loop code that doesn't yield.  That keeps a fixed
+  // cadence through a slow loop made of many short components, not through one long blocking one.
+  static constexpr uint8_t TIMED_FRAMES = 16;  // segments between sampled frames, interpolated linearly
+  struct TimedFrames {
+    float levels[TIMED_FRAMES + 1][5];
+  };
+  light::RenderBuffer<TimedFrames> timed_frames_;
+  light::LightTransformer *timed_transformer_{nullptr};
+  uint32_t timed_start_us_{0};
+  uint32_t timed_length_us_{0};
+#ifdef USE_ESP8266
+  os_timer_t timed_timer_{};
+#endif
+#ifdef USE_ESP32
+  esp_timer_handle_t timed_timer_{nullptr};
+#endif
+  Mutex timed_lock_;  // a timer step against stop_timed_transition() from the loop
+  // inter-frame interval statistics (Welford), logged when the transition ends
+  uint32_t timed_last_us_{0};
+  uint32_t timed_intervals_{0};
+  float timed_mean_{0.0f};
+  float timed_m2_{0.0f};
+  bool sample_timed_transition_();
+  void step_timed_transition_();
+  void arm_timed_timer_();
+  void disarm_timed_timer_();
+  static void timed_tick_(void *arg);
+#endif
+
+#if defined(KAUF_PWM_DITHER) || defined(KAUF_TIMED_TRANSITIONS)
+  // main light state, for outputs written outside write_state()
+  light::LightState *state_{nullptr};
+#endif
+
+#ifdef USE_LIGHT_SCENES
+  // levels of the last write_state(), and whether they were for settled values (no transition, no DDP)
+  float levels_[light::LIGHT_SCENE_LEVELS]{};
+  bool levels_settled_{false};
+  // aux lights add to the mix, so levels captured or replayed with one on wouldn't be right
+  bool aux_on_();
+#endif
+
+#ifdef KAUF_OUTPUT_HANDOFF
+  // last steady-state output levels.  Mirrored into RTC memory (CRC checked by preferences) so that
+  // setup_state() can put them straight back on the PWM outputs after a warm reset.
+  struct OutputHandoff {
+    float red;
+    float green;
+    float blue;
+    float cold;
+    float warm;
+  };
+  ESPPreferenceObject handoff_rtc_;
+  OutputHandoff handoff_{};
+  bool handoff_applied_{false};
+  void mirror_outputs_(float red, float green, float blue, float cold, float warm);
+#endif
+
 };
 
 } //namespace esphome::kauf_rgbww
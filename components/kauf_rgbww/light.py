@@ -2,6 +2,7 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import light, output
 from esphome.core import CORE
+import esphome.final_validate as fv
 from esphome.const import (
     CONF_BLUE,
     CONF_COLOR_INTERLOCK,
@@ -15,6 +16,7 @@ from esphome.const import (
     CONF_WARM_WHITE_COLOR_TEMPERATURE,
     CONF_FREQUENCY,
     CONF_ID,
+    CONF_PLATFORM,
 )
 
 kauf_rgbww_ns = cg.esphome_ns.namespace('kauf_rgbww')
@@ -54,6 +56,14 @@ def validate_kauf_light(value):
             raise cv.Invalid("Aux KAUF Light should not have a warm_rgb light.")
         if ( "cold_rgb" in value ):
             raise cv.Invalid("Aux KAUF Light should not have a cold_rgb light.")
+        if ( "min_visible_steps" in value ):
+            raise cv.Invalid("Aux KAUF Light should not have min_visible_steps.")
+        if ( value["dither"] ):
+            raise cv.Invalid("Aux KAUF Light should not have dither.")
+        if ( value["timed_transitions"] ):
+            raise cv.Invalid("Aux KAUF Light should not have timed_transitions.")
+        if ( value["single_output"] ):
+            raise cv.Invalid("Aux KAUF Light should not have single_output, set it on the main light.")
         if value["aux"] in ("warm", "cold") and "main_light" not in value:
             raise cv.Invalid("Aux KAUF Light with aux: warm/cold requires a main_light.")
         if value["aux"] is True and "main_light" in value:
@@ -91,6 +101,19 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional("warm_rgb"): cv.use_id(light.LightState),
             cv.Optional("aux", default=False): cv.Any(cv.boolean, cv.one_of("main", "warm", "cold", lower=True)),
             cv.Optional("main_light"): cv.use_id(light.LightState),
+            cv.Optional("output_handoff", default=True): cv.boolean,
+            cv.Optional("dither", default=False): cv.boolean,
+            cv.Optional("single_output", default=False): cv.boolean,
+            cv.Optional("timed_transitions", default=False): cv.boolean,
+            cv.Optional("min_visible_steps"): cv.Schema(
+                {
+                    cv.Optional(CONF_RED, default=0): cv.uint16_t,
+                    cv.Optional(CONF_GREEN, default=0): cv.uint16_t,
+                    cv.Optional(CONF_BLUE, default=0): cv.uint16_t,
+                    cv.Optional(CONF_COLD_WHITE, default=0): cv.uint16_t,
+                    cv.Optional(CONF_WARM_WHITE, default=0): cv.uint16_t,
+                }
+            ),
         }
     ),
     cv.has_none_or_all_keys(
@@ -101,6 +124,22 @@ CONFIG_SCHEMA = cv.All(
 )
 
 
+def _final_validate_single_output(config):
+    # LightState calls its output as KaufRGBWWLight directly with single_output, so every light has to be one
+    if not config.get("single_output"):
+        return config
+    for light_conf in fv.full_config.get().get("light", []):
+        if light_conf.get(CONF_PLATFORM) != "kauf_rgbww":
+            raise cv.Invalid(
+                f"single_output requires every light to be a kauf_rgbww light, found platform "
+                f"'{light_conf.get(CONF_PLATFORM)}'."
+            )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate_single_output
+
+
 async def to_code(config):
 
     var = cg.new_Pvariable(config[CONF_OUTPUT_ID])
@@ -140,6 +179,10 @@ async def to_code(config):
         if _output_has_align_pin(config[CONF_WARM_WHITE].id):
             cg.add(var.set_warm_white_pwm(wwhite))
 
+        # mirror output levels into RTC memory so a warm reset doesn't blink the bulb
+        if config["output_handoff"] and CORE.is_esp8266:
+            cg.add_define("KAUF_OUTPUT_HANDOFF")
+
         # Calculate PWM steps for each channel based on output frequency
         # steps = 1,000,000 / frequency (e.g., 125Hz -> 8000 steps, 1000Hz -> 1000 steps)
         cg.add_define("KAUF_PWM_STEPS_RED", get_pwm_steps_for_output(config[CONF_RED].id))
@@ -148,6 +191,34 @@ async def to_code(config):
         cg.add_define("KAUF_PWM_STEPS_COLD", get_pwm_steps_for_output(config[CONF_COLD_WHITE].id))
         cg.add_define("KAUF_PWM_STEPS_WARM", get_pwm_steps_for_output(config[CONF_WARM_WHITE].id))
 
+        # lowest non-zero level per channel, in that channel's PWM steps.  Levels that gamma correction
+        # leaves below one step would otherwise round to off at low brightness.
+        if "min_visible_steps" in config:
+            floors = config["min_visible_steps"]
+            cg.add_define("KAUF_PWM_MIN_VISIBLE")
+            cg.add_define("KAUF_PWM_MIN_VISIBLE_RED", floors[CONF_RED])
+            cg.add_define("KAUF_PWM_MIN_VISIBLE_GREEN", floors[CONF_GREEN])
+            cg.add_define("KAUF_PWM_MIN_VISIBLE_BLUE", floors[CONF_BLUE])
+            cg.add_define("KAUF_PWM_MIN_VISIBLE_COLD", floors[CONF_COLD_WHITE])
+            cg.add_define("KAUF_PWM_MIN_VISIBLE_WARM", floors[CONF_WARM_WHITE])
+
+        # temporal dithering between PWM steps.  Runs from the output's own loop, held at high frequency while
+        # it dithers, so only then is it a component.
+        if config["dither"]:
+            cg.add_define("KAUF_PWM_DITHER")
+            cg.add(var.set_dither(True))
+            await cg.register_component(var, config)
+
+        # step transitions from a timer instead of the main loop.  An esp_timer on ESP32, which also steps while the
+        # loop is blocked.  timer1 belongs to the PWM waveform generator on ESP8266, so there it's the SDK software
+        # timer, which runs between loop passes and while the loop yields or delays, but not during blocking code.
+        if config["timed_transitions"] and (CORE.is_esp8266 or CORE.is_esp32):
+            cg.add_define("KAUF_TIMED_TRANSITIONS")
+
+        # every light is a KaufRGBWWLight (checked in final validation), so LightState can call it as one
+        if config["single_output"]:
+            cg.add_define("KAUF_SINGLE_OUTPUT")
+
     # register light
     light_state = await light.register_light(var, config)
 
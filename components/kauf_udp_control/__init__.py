@@ -0,0 +1,62 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import light
+from esphome.components import time as time_
+from esphome.const import CONF_ID, CONF_PORT, CONF_TIME_ID
+
+DEPENDENCIES = ["light", "wifi"]
+
+kauf_udp_control_ns = cg.esphome_ns.namespace("kauf_udp_control")
+KaufUDPControl = kauf_udp_control_ns.class_("KaufUDPControl", cg.Component)
+
+CONF_LIGHTS = "lights"
+CONF_GROUPS = "groups"
+CONF_MULTICAST_ADDRESS = "multicast_address"
+
+
+def validate_groups(value):
+    if value.get(CONF_GROUPS) and CONF_TIME_ID not in value:
+        raise cv.Invalid("Group commands need a time_id (e.g. sntp) for the shared start clock.")
+    return value
+
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(KaufUDPControl),
+            cv.Optional(CONF_PORT, default=4049): cv.port,
+            # packet light index is the position in this list
+            cv.Required(CONF_LIGHTS): cv.All(
+                cv.ensure_list(cv.use_id(light.LightState)), cv.Length(min=1, max=255)
+            ),
+            # group commands go to the first light in lights:
+            cv.Optional(CONF_GROUPS): cv.All(
+                cv.ensure_list(cv.int_range(min=1, max=255)), cv.Length(min=1)
+            ),
+            cv.Optional(
+                CONF_MULTICAST_ADDRESS, default="239.255.75.76"
+            ): cv.ipv4address_multi_broadcast,
+            cv.Optional(CONF_TIME_ID): cv.use_id(time_.RealTimeClock),
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    cv.only_with_arduino,
+    validate_groups,
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    cg.add(var.set_port(config[CONF_PORT]))
+    for light_id in config[CONF_LIGHTS]:
+        ls = await cg.get_variable(light_id)
+        cg.add(var.add_light(ls))
+
+    if groups := config.get(CONF_GROUPS):
+        for group in groups:
+            cg.add(var.add_group(group))
+        addr = config[CONF_MULTICAST_ADDRESS]
+        cg.add(var.set_multicast_address(*[int(x) for x in str(addr).split(".")]))
+        time_var = await cg.get_variable(config[CONF_TIME_ID])
+        cg.add(var.set_time(time_var))
@@ -0,0 +1,284 @@
+#include <cinttypes>
+#include "kauf_udp_control.h"
+#include "udp_fields.h"
+#include "esphome/core/log.h"
+#include "esphome/components/wifi/wifi_component.h"
+#include "esphome/components/light/light_json_schema.h"
+
+#include <sys/time.h>
+#ifdef USE_ESP8266
+#include <ESP8266WiFi.h>
+#endif
+
+namespace esphome::kauf_udp_control {
+
+static const char *TAG = "kauf_udp_control";
+
+using light::LightCall;
+
+// the wire mask is LightCall's own
+static constexpr bool same_bit(FieldBit wire, LightCall::FieldFlags flag) { return uint16_t(wire) == uint16_t(flag); }
+static_assert(same_bit(FIELD_BRIGHTNESS, LightCall::FLAG_HAS_BRIGHTNESS), "udp_fields.h out of step");
+static_assert(same_bit(FIELD_COLOR_BRIGHTNESS, LightCall::FLAG_HAS_COLOR_BRIGHTNESS), "udp_fields.h out of step");
+static_assert(same_bit(FIELD_RED, LightCall::FLAG_HAS_RED), "udp_fields.h out of step");
+static_assert(same_bit(FIELD_GREEN, LightCall::FLAG_HAS_GREEN), "udp_fields.h out of step");
+static_assert(same_bit(FIELD_BLUE, LightCall::FLAG_HAS_BLUE), "udp_fields.h out of step");
+static_assert(same_bit(FIELD_WHITE, LightCall::FLAG_HAS_WHITE), "udp_fields.h out of step");
+static_assert(same_bit(FIELD_COLD_WHITE, LightCall::FLAG_HAS_COLD_WHITE), "udp_fields.h out of step");
+static_assert(same_bit(FIELD_WARM_WHITE, LightCall::FLAG_HAS_WARM_WHITE), "udp_fields.h out of step");
+static_assert(same_bit(FIELD_COLOR_TEMPERATURE, LightCall::FLAG_HAS_COLOR_TEMPERATURE), "udp_fields.h out of step");
+static_assert(same_bit(FIELD_STATE, LightCall::FLAG_HAS_STATE), "udp_fields.h out of step");
+static_assert(same_bit(FIELD_TRANSITION, LightCall::FLAG_HAS_TRANSITION), "udp_fields.h out of step");
+static_assert(same_bit(FIELD_FLASH, LightCall::FLAG_HAS_FLASH), "udp_fields.h out of step");
+static_assert(same_bit(FIELD_EFFECT, LightCall::FLAG_HAS_EFFECT), "udp_fields.h out of step");
+static_assert(same_bit(FIELD_COLOR_MODE, LightCall::FLAG_HAS_COLOR_MODE), "udp_fields.h out of step");
+static_assert(same_bit(FIELD_PUBLISH, LightCall::FLAG_PUBLISH), "udp_fields.h out of step");
+static_assert(same_bit(FIELD_SAVE, LightCall::FLAG_SAVE), "udp_fields.h out of step");
+
+void KaufUDPControl::loop() {
+  // listen lazily once wifi is up, same as DDP
+  if (!this->udp_) {
+    if (!wifi::global_wifi_component->is_connected()) return;
+    this->udp_ = make_unique<WiFiUDP>();
+    // joining the multicast group also listens for unicast on the same port
+    bool ok;
+    if (this->groups_.empty()) {
+      ok = this->udp_->begin(this->port_);
+    } else {
+#ifdef USE_ESP8266
+      ok = this->udp_->beginMulticast(WiFi.localIP(), this->multicast_address_, this->port_);
+#else
+      ok = this->udp_->beginMulticast(this->multicast_address_, this->port_);
+#endif
+    }
+    if (!ok) {
+      ESP_LOGE(TAG, "Cannot bind to port %u", this->port_);
+      this->udp_.reset();
+      this->mark_failed();
+      return;
+    }
+    ESP_LOGD(TAG, "Listening on port %u", this->port_);
+  }
+
+  uint8_t buf[MAX_PACKET_SIZE];
+  while (int packet_size = this->udp_->parsePacket()) {
+    // oversized packets aren't ours, the next parsePacket() discards what's left of them
+    if (packet_size > MAX_PACKET_SIZE) {
+      this->error_count_++;
+      continue;
+    }
+    int len = this->udp_->read(buf, packet_size);
+    if (len <= 0) return;
+    this->handle_packet_(buf, len);
+  }
+
+  if (this->group_call_.has_value() && this->epoch_ms_() >= this->group_start_) {
+    this->perform_group_call_();
+  }
+}
+
+void KaufUDPControl::handle_packet_(const uint8_t *data, size_t len) {
+  if (len >= GROUP_HEADER_SIZE && data[0] == MAGIC_0 && data[1] == MAGIC_1 && data[2] == VERSION &&
+      data[3] == OP_GROUP_CALL) {
+    this->handle_group_packet_(data, len);
+    return;
+  }
+
+  const uint8_t op = len >= HEADER_SIZE ? data[3] : 0;
+  if (len < HEADER_SIZE || data[0] != MAGIC_0 || data[1] != MAGIC_1 || data[2] != VERSION ||
+      (op != OP_CALL && op != OP_SCENE_RECALL && op != OP_SCENE_STORE && op != OP_STATE)) {
+    ESP_LOGV(TAG, "Ignoring %u byte packet, not a version %u command", (unsigned) len, VERSION);
+    this->error_count_++;
+    return;
+  }
+
+  const uint16_t seq = data[4] | (uint16_t(data[5]) << 8);
+  const uint8_t index = data[6];
+  const bool ack = data[7] & PACKET_ACK_REQUESTED;
+  const uint16_t mask = data[8] | (uint16_t(data[9]) << 8);
+
+  if (index >= this->lights_.size()) {
+    this->error_count_++;
+    if (ack) this->send_ack_(seq, index, ACK_BAD_LIGHT);
+    return;
+  }
+
+  // queries don't change anything, no sequence tracking
+  if (op == OP_STATE) {
+    this->send_state_(seq, index);
+    return;
+  }
+
+  // a retransmit after a lost ack, just ack again
+  if (this->has_seq_[index] && this->last_seq_[index] == seq) {
+    if (ack) this->send_ack_(seq, index, ACK_DUPLICATE);
+    return;
+  }
+
+  if (op != OP_CALL) {
+    const AckStatus status = this->handle_scene_(data, len, this->lights_[index]);
+    if (status == ACK_OK) {
+      this->last_seq_[index] = seq;
+      this->has_seq_[index] = true;
+      this->command_count_++;
+    } else {
+      this->error_count_++;
+    }
+    if (ack) this->send_ack_(seq, index, status);
+    return;
+  }
+
+  auto call = this->lights_[index]->make_call();
+  if (!this->decode_fields_(data + HEADER_SIZE, len - HEADER_SIZE, mask, call)) {
+    this->error_count_++;
+    if (ack) this->send_ack_(seq, index, ACK_MALFORMED);
+    return;
+  }
+
+  this->last_seq_[index] = seq;
+  this->has_seq_[index] = true;
+  this->command_count_++;
+  call.perform();
+
+  if (ack) this->send_ack_(seq, index, ACK_OK);
+}
+
+KaufUDPControl::AckStatus KaufUDPControl::handle_scene_(const uint8_t *data, size_t len, light::LightState *light) {
+#ifdef USE_LIGHT_SCENES
+  const uint8_t slot = data[8];
+  const uint8_t flags = data[9];
+  const bool has_transition = flags & SCENE_TRANSITION;
+  if (len != HEADER_SIZE + (has_transition ? 4u : 0u)) return ACK_MALFORMED;
+
+  if (data[3] == OP_SCENE_STORE) return light->store_scene(slot) ? ACK_OK : ACK_BAD_SCENE;
+
+  optional<uint32_t> transition_length{};
+  if (has_transition) {
+    FieldReader in{data + HEADER_SIZE, data + len};
+    transition_length = in.u32();
+  }
+  return light->recall_scene(slot, transition_length, flags & SCENE_SAVE) ? ACK_OK : ACK_BAD_SCENE;
+#else
+  return ACK_BAD_SCENE;  // no light has scene slots
+#endif
+}
+
+bool KaufUDPControl::decode_fields_(const uint8_t *data, size_t len, uint16_t mask, LightCall &call) {
+  return decode_fields<light::ColorMode>(data, len, mask, call);
+}
+
+void KaufUDPControl::send_ack_(uint16_t seq, uint8_t light_index, AckStatus status) {
+  const uint8_t ack[8] = {MAGIC_0, MAGIC_1, VERSION, OP_ACK, uint8_t(seq), uint8_t(seq >> 8), light_index, status};
+  this->udp_->beginPacket(this->udp_->remoteIP(), this->udp_->remotePort());
+  this->udp_->write(ack, sizeof(ack));
+  this->udp_->endPacket();
+}
+
+void KaufUDPControl::send_state_(uint16_t seq, uint8_t light_index) {
+  const char *json = nullptr;
+  size_t len = 0;
+#ifdef USE_JSON
+  json = light::LightJSONSchema::get_cached_json(*this->lights_[light_index], &len);
+#endif
+  if (json == nullptr) {
+    this->send_ack_(seq, light_index, ACK_NO_STATE);
+    return;
+  }
+
+  const uint8_t header[8] = {MAGIC_0, MAGIC_1, VERSION, OP_STATE, uint8_t(seq), uint8_t(seq >> 8), light_index, ACK_OK};
+  this->udp_->beginPacket(this->udp_->remoteIP(), this->udp_->remotePort());
+  this->udp_->write(header, sizeof(header));
+  this->udp_->write(reinterpret_cast<const uint8_t *>(json), len);
+  this->udp_->endPacket();
+}
+
+void KaufUDPControl::handle_group_packet_(const uint8_t *data, size_t len) {
+  const uint16_t seq = data[4] | (uint16_t(data[5]) << 8);
+  const uint8_t group = data[6];
+  const uint16_t mask = data[8] | (uint16_t(data[9]) << 8);
+
+  size_t slot = 0;
+  while (slot < this->groups_.size() && this->groups_[slot] != group) slot++;
+  if (slot == this->groups_.size()) return;  // not one of ours
+
+  if (this->has_group_seq_[slot] && this->last_group_seq_[slot] == seq) return;  // repeat
+
+  uint64_t start = 0;
+  for (int i = 7; i >= 0; i--) start = (start << 8) | data[HEADER_SIZE + i];
+
+  auto call = this->lights_[0]->make_call();
+  if (!this->decode_fields_(data + GROUP_HEADER_SIZE, len - GROUP_HEADER_SIZE, mask, call)) {
+    this->error_count_++;
+    return;
+  }
+  this->last_group_seq_[slot] = seq;
+  this->has_group_seq_[slot] = true;
+
+  // without a synced clock there is nothing to line up with, just go
+#ifdef USE_TIME
+  const bool synced = this->time_ != nullptr && this->time_->now().is_valid();
+#else
+  const bool synced = false;
+#endif
+  if (!synced) {
+    ESP_LOGW(TAG, "Group %u command before time is synced, performing now", group);
+    call.perform();
+    this->command_count_++;
+    return;
+  }
+
+  // the loop spins at full speed until the start, so don't wait on a bad or far-future clock
+  const uint64_t now = this->epoch_ms_();
+  if (start > now + MAX_GROUP_LEAD_MS) {
+    ESP_LOGW(TAG, "Group %u command starts %" PRIu64 " ms ahead, more than %" PRIu32 " ms, ignored", group,
+             start - now, MAX_GROUP_LEAD_MS);
+    this->error_count_++;
+    return;
+  }
+
+  // a newer command for the light replaces one that hasn't started yet
+  if (this->group_call_.has_value()) {
+    ESP_LOGD(TAG, "Group %u command replaced before its start", this->group_id_);
+  }
+  this->group_call_ = call;
+  this->group_start_ = start;
+  this->group_id_ = group;
+
+  // loop as fast as possible until the start time, otherwise the 16ms loop interval is the drift floor
+  this->high_freq_.start();
+  if (now >= start) this->perform_group_call_();
+}
+
+void KaufUDPControl::perform_group_call_() {
+  const int64_t drift = int64_t(this->epoch_ms_()) - int64_t(this->group_start_);
+  this->group_call_->perform();
+  this->group_call_.reset();
+  this->high_freq_.stop();
+  this->command_count_++;
+
+  this->last_group_drift_ = int32_t(drift);
+  if (abs(this->last_group_drift_) > abs(this->max_group_drift_)) this->max_group_drift_ = this->last_group_drift_;
+  ESP_LOGD(TAG, "Group %u start drift %" PRId32 " ms (worst %" PRId32 " ms)", this->group_id_,
+           this->last_group_drift_, this->max_group_drift_);
+}
+
+uint64_t KaufUDPControl::epoch_ms_() {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return uint64_t(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+}
+
+void KaufUDPControl::dump_config() {
+  ESP_LOGCONFIG(TAG, "Kauf UDP Control:");
+  ESP_LOGCONFIG(TAG, "  Port: %u", this->port_);
+  ESP_LOGCONFIG(TAG, "  Lights: %u", (unsigned) this->lights_.size());
+  ESP_LOGCONFIG(TAG, "  Commands: %" PRIu32 ", errors: %" PRIu32, this->command_count_, this->error_count_);
+  if (!this->groups_.empty()) {
+    ESP_LOGCONFIG(TAG, "  Multicast: %s, %u groups", this->multicast_address_.toString().c_str(),
+                  (unsigned) this->groups_.size());
+    ESP_LOGCONFIG(TAG, "  Group start drift: last %" PRId32 " ms, worst %" PRId32 " ms", this->last_group_drift_,
+                  this->max_group_drift_);
+  }
+}
+
+} // namespace esphome::kauf_udp_control
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/light/light_state.h"
+#ifdef USE_TIME
+#include "esphome/components/time/real_time_clock.h"
+#endif
+
+#include <WiFiUdp.h>
+#include <memory>
+#include <vector>
+
+namespace esphome::kauf_udp_control {
+
+/* Compact binary light control over UDP.  All multi-byte values are little endian.
+ *
+ * Command packet:
+ *   0-1   magic 'K' 'L'
+ *   2     protocol version (1)
+ *   3     opcode (OP_CALL)
+ *   4-5   sequence number, echoed in the ack
+ *   6     light index (position in the lights: list)
+ *   7     packet flags (PACKET_ACK_REQUESTED)
+ *   8-9   field mask, same bits as light::LightCall::FieldFlags
+ *   10-   one value per set field, in bit order:
+ *           bits 0-7  brightness .. warm white   uint8, 0-255
+ *           bit 8     color temperature          uint16, mireds
+ *           bit 9     state                      uint8, 0 = off
+ *           bit 10    transition length          uint32, ms
+ *           bit 11    flash length               uint32, ms
+ *           bit 12    effect index               uint16, 0 = none
+ *           bit 13    color mode                 uint8, light::ColorMode
+ *           bit 14    publish                    no value, always published
+ *           bit 15    save                       no value, save to flash if set
+ *
+ * Ack packet: magic, version, OP_ACK, sequence number, light index, status (AckStatus).
+ *
+ * Group command packet (sent to the multicast address, never acked):
+ *   0-5   same as a command, opcode OP_GROUP_CALL
+ *   6     group id
+ *   7     packet flags (ignored)
+ *   8-9   field mask
+ *   10-17 start time, uint64 ms since the unix epoch on the shared (SNTP) clock
+ *   18-   field values as above
+ * Every bulb subscribed to the group performs the call on its first light at the start time, so transitions
+ * across a group begin together.  Start times more than MAX_GROUP_LEAD_MS ahead are rejected.  Senders may repeat a group packet for reliability, repeats of the last
+ * sequence number for a group are ignored.
+ *
+ * Scene packet (lights with scene_slots), acked like a command:
+ *   0-7   same as a command, opcode OP_SCENE_RECALL or OP_SCENE_STORE
+ *   8     scene slot
+ *   9     scene flags (SCENE_SAVE, SCENE_TRANSITION)
+ *   10-13 transition length, uint32 ms, only with SCENE_TRANSITION.  Default transition length otherwise.
+ * A recall goes straight to the stored values, see light::LightState::recall_scene().
+ *
+ * State query packet: the first 8 bytes of a command with opcode OP_STATE, field mask 0.  Answered with
+ * magic, version, OP_STATE, sequence number, light index, status, then the light's JSON state (same text as
+ * the MQTT / web_server JSON, not null terminated).  The JSON comes from light::LightJSONSchema::get_cached_json(),
+ * so any number of pollers cost one encode per state change.  Needs the json component (USE_JSON).
+ *
+ * Commands are performed as regular LightCalls so they are validated, published and saved exactly like
+ * commands from Home Assistant.  Unlike DDP they never write the outputs directly.
+ */
+class KaufUDPControl : public Component {
+ public:
+  static const uint8_t MAGIC_0 = 'K';
+  static const uint8_t MAGIC_1 = 'L';
+  static const uint8_t VERSION = 1;
+  static const uint8_t HEADER_SIZE = 10;
+  static const uint8_t MAX_PACKET_SIZE = 64;
+
+  enum Opcode : uint8_t {
+    OP_CALL = 1,
+    OP_ACK = 2,
+    OP_GROUP_CALL = 3,
+    OP_SCENE_RECALL = 4,
+    OP_SCENE_STORE = 5,
+    OP_STATE = 6,
+  };
+
+  enum SceneFlags : uint8_t {
+    SCENE_SAVE = 1 << 0,
+    SCENE_TRANSITION = 1 << 1,
+  };
+  static const uint8_t GROUP_HEADER_SIZE = HEADER_SIZE + 8;
+  /// Group commands starting further ahead than this are dropped.
+  static const uint32_t MAX_GROUP_LEAD_MS = 5000;
+
+  enum PacketFlags : uint8_t {
+    PACKET_ACK_REQUESTED = 1 << 0,
+  };
+
+  enum AckStatus : uint8_t {
+    ACK_OK = 0,
+    ACK_DUPLICATE = 1,   // same sequence number as the last command for this light, not performed again
+    ACK_BAD_LIGHT = 2,
+    ACK_MALFORMED = 3,
+    ACK_BAD_SCENE = 4,   // no such scene slot, or nothing stored in it
+    ACK_NO_STATE = 5,    // state query without the json component, or the state didn't fit the cache
+  };
+
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+
+  void set_port(uint16_t port) { port_ = port; }
+  void add_light(light::LightState *light) {
+    lights_.push_back(light);
+    last_seq_.push_back(0);
+    has_seq_.push_back(false);
+  }
+
+  void add_group(uint8_t group) {
+    groups_.push_back(group);
+    last_group_seq_.push_back(0);
+    has_group_seq_.push_back(false);
+  }
+  void set_multicast_address(uint8_t a, uint8_t b, uint8_t c, uint8_t d) { multicast_address_ = IPAddress(a, b, c, d); }
+#ifdef USE_TIME
+  void set_time(time::RealTimeClock *time) { time_ = time; }
+#endif
+
+  uint32_t get_command_count() const { return command_count_; }
+  uint32_t get_error_count() const { return error_count_; }
+
+  /// Group start drift in ms (actual - requested start) of the last group command, and the worst seen.
+  int32_t get_last_group_drift() const { return last_group_drift_; }
+  int32_t get_max_group_drift() const { return max_group_drift_; }
+
+ protected:
+  /// Decode the fields after the header into call.  Returns false if the packet is short or has leftovers.
+  bool decode_fields_(const uint8_t *data, size_t len, uint16_t mask, light::LightCall &call);
+  void handle_packet_(const uint8_t *data, size_t len);
+  /// Perform a scene packet for an already checked light.  Returns the status to ack with.
+  AckStatus handle_scene_(const uint8_t *data, size_t len, light::LightState *light);
+  void send_ack_(uint16_t seq, uint8_t light_index, AckStatus status);
+  /// Answer a state query with the light's cached JSON state.
+  void send_state_(uint16_t seq, uint8_t light_index);
+  void handle_group_packet_(const uint8_t *data, size_t len);
+  void perform_group_call_();
+  /// ms since the unix epoch from the system clock, which the time component keeps synced.
+  uint64_t epoch_ms_();
+
+  std::unique_ptr<WiFiUDP> udp_;
+  uint16_t port_{4049};
+
+  std::vector<light::LightState *> lights_;
+  std::vector<uint16_t> last_seq_;
+  std::vector<bool> has_seq_;
+
+  uint32_t command_count_{0};
+  uint32_t error_count_{0};
+
+  std::vector<uint8_t> groups_;
+  std::vector<uint16_t> last_group_seq_;
+  std::vector<bool> has_group_seq_;
+  IPAddress multicast_address_;
+#ifdef USE_TIME
+  time::RealTimeClock *time_{nullptr};
+#endif
+
+  // group command waiting for its start time
+  optional<light::LightCall> group_call_;
+  uint64_t group_start_{0};
+  uint8_t group_id_{0};
+  HighFrequencyLoopRequester high_freq_;
+
+  int32_t last_group_drift_{0};
+  int32_t max_group_drift_{0};
+};
+
+} // namespace esphome::kauf_udp_control
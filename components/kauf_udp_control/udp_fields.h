@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome::kauf_udp_control {
+
+// KAUF: the field section of command and group packets (see kauf_udp_control.h for the layout).  No ESPHome
+// dependencies, so tests/udp_fields_test.cpp load tests the decoder on the host.
+
+/// Field mask bits, the same as light::LightCall::FieldFlags (checked in kauf_udp_control.cpp).
+enum FieldBit : uint16_t {
+  FIELD_BRIGHTNESS = 1 << 0,
+  FIELD_COLOR_BRIGHTNESS = 1 << 1,
+  FIELD_RED = 1 << 2,
+  FIELD_GREEN = 1 << 3,
+  FIELD_BLUE = 1 << 4,
+  FIELD_WHITE = 1 << 5,
+  FIELD_COLD_WHITE = 1 << 6,
+  FIELD_WARM_WHITE = 1 << 7,
+  FIELD_COLOR_TEMPERATURE = 1 << 8,
+  FIELD_STATE = 1 << 9,
+  FIELD_TRANSITION = 1 << 10,
+  FIELD_FLASH = 1 << 11,
+  FIELD_EFFECT = 1 << 12,
+  FIELD_COLOR_MODE = 1 << 13,
+  FIELD_PUBLISH = 1 << 14,
+  FIELD_SAVE = 1 << 15,
+};
+
+// bounds checked little endian reader over the field section
+struct FieldReader {
+  const uint8_t *pos;
+  const uint8_t *end;
+  bool ok{true};
+
+  uint8_t u8() {
+    if (this->end - this->pos < 1) {
+      this->ok = false;
+      return 0;
+    }
+    return *this->pos++;
+  }
+  uint16_t u16() {
+    uint16_t lo = this->u8();
+    return lo | (uint16_t(this->u8()) << 8);
+  }
+  uint32_t u32() {
+    uint32_t lo = this->u16();
+    return lo | (uint32_t(this->u16()) << 16);
+  }
+};
+
+/** Decode the fields after the header into call.  Returns false if the packet is short or has leftovers.
+ *
+ * Call is light::LightCall, or a recording stand-in on the host.  ColorMode is what the color mode byte is cast to.
+ */
+template<typename ColorMode, typename Call> bool decode_fields(const uint8_t *data, size_t len, uint16_t mask,
+                                                               Call &call) {
+  FieldReader in{data, data + len};
+
+  // bits 0-7 are the unit fields, in LightCall::FieldFlags order
+  if (mask & FIELD_BRIGHTNESS) call.set_brightness(in.u8() / 255.0f);
+  if (mask & FIELD_COLOR_BRIGHTNESS) call.set_color_brightness(in.u8() / 255.0f);
+  if (mask & FIELD_RED) call.set_red(in.u8() / 255.0f);
+  if (mask & FIELD_GREEN) call.set_green(in.u8() / 255.0f);
+  if (mask & FIELD_BLUE) call.set_blue(in.u8() / 255.0f);
+  if (mask & FIELD_WHITE) call.set_white(in.u8() / 255.0f);
+  if (mask & FIELD_COLD_WHITE) call.set_cold_white(in.u8() / 255.0f);
+  if (mask & FIELD_WARM_WHITE) call.set_warm_white(in.u8() / 255.0f);
+
+  if (mask & FIELD_COLOR_TEMPERATURE) call.set_color_temperature(float(in.u16()));
+  if (mask & FIELD_STATE) call.set_state(in.u8() != 0);
+  if (mask & FIELD_TRANSITION) call.set_transition_length(in.u32());
+  if (mask & FIELD_FLASH) call.set_flash_length(in.u32());
+  if (mask & FIELD_EFFECT) call.set_effect(uint32_t(in.u16()));
+  if (mask & FIELD_COLOR_MODE) call.set_color_mode(static_cast<ColorMode>(in.u8()));
+
+  // always publish so Home Assistant stays in sync, saving is up to the sender
+  call.set_save((mask & FIELD_SAVE) != 0);
+
+  return in.ok && in.pos == in.end;
+}
+
+}  // namespace esphome::kauf_udp_control
@@ -58,6 +58,7 @@ from .effects import (
     RGB_EFFECTS,
     validate_effects,
 )
+from .gamma_tables import gamma_reverse_tables, gamma_table
 from .types import (  # noqa: F401
     AddressableLight,
     AddressableLightState,
@@ -99,7 +100,8 @@ class EffectCycleRef:
 
 @dataclass
 class LightData:
-    gamma_tables: dict = field(default_factory=dict)  # gamma_value -> fwd_arr
+    # gamma_value -> (fwd_arr, rev_arr, rev8_arr)
+    gamma_tables: dict = field(default_factory=dict)
     effect_refs: list[EffectRef] = field(default_factory=list)
     effect_cycle_refs: list[EffectCycleRef] = field(default_factory=list)
 
@@ -111,23 +113,16 @@ def _get_data() -> LightData:
 
 
 def generate_gamma_table(gamma_correct: float) -> list[HexInt]:
-    """Generate a 256-entry uint16 gamma lookup table.
+    """Generate a 256-entry uint16 gamma lookup table, see gamma_tables.gamma_table()."""
+    return [HexInt(x) for x in gamma_table(gamma_correct)]
 
-    For gamma > 0, non-zero indices are clamped to a minimum of 1 to preserve
-    the invariant that non-zero input always produces non-zero output. Without
-    this, small brightness values (e.g. 1%) get quantized to exactly 0.0,
-    which breaks zero_means_zero logic in FloatOutput.
-    """
-    if gamma_correct > 0:
-        return [
-            HexInt(
-                max(1, min(65535, int(round((i / 255.0) ** gamma_correct * 65535))))
-                if i > 0
-                else HexInt(0)
-            )
-            for i in range(256)
-        ]
-    return [HexInt(int(round(i / 255.0 * 65535))) for i in range(256)]
+
+def generate_gamma_reverse_tables(
+    forward: list[HexInt],
+) -> tuple[list[HexInt], list[HexInt]]:
+    """KAUF: the reverse tables of a forward gamma table, see gamma_tables.gamma_reverse_tables()."""
+    reverse, reverse8 = gamma_reverse_tables(forward)
+    return [HexInt(x) for x in reverse], [HexInt(x) for x in reverse8]
 
 
 def _get_or_create_gamma_table(gamma_correct):
@@ -136,12 +131,17 @@ def _get_or_create_gamma_table(gamma_correct):
         return data.gamma_tables[gamma_correct]
 
     forward = generate_gamma_table(gamma_correct)
+    reverse, reverse8 = generate_gamma_reverse_tables(forward)
 
     gamma_str = f"{gamma_correct}".replace(".", "_")
     fwd_id = ID(f"gamma_{gamma_str}_fwd", is_declaration=True, type=cg.uint16)
     fwd_arr = cg.progmem_array(fwd_id, forward)
-    data.gamma_tables[gamma_correct] = fwd_arr
-    return fwd_arr
+    rev_id = ID(f"gamma_{gamma_str}_rev", is_declaration=True, type=cg.uint16)
+    rev_arr = cg.progmem_array(rev_id, reverse)
+    rev8_id = ID(f"gamma_{gamma_str}_rev8", is_declaration=True, type=cg.uint8)
+    rev8_arr = cg.progmem_array(rev8_id, reverse8)
+    data.gamma_tables[gamma_correct] = (fwd_arr, rev_arr, rev8_arr)
+    return data.gamma_tables[gamma_correct]
 
 
 def find_effect_index(effects: list, effect_name: str) -> int | None:
@@ -165,12 +165,55 @@ def available_effects_str(effects: list) -> str:
     return ", ".join(f"'{name}'" for name in available) if available else "none"
 
 
+# KAUF: on ESP8266 scene slots take forced flash addresses from scene_addr on, 9 words each (8 data words and
+# the checksum, see LightSceneRecord).  The flash preference area is 128 words, see the map in kauf-bulb.yaml.
+CONF_SCENE_SLOTS = "scene_slots"
+CONF_SCENE_ADDR = "scene_addr"
+SCENE_RECORD_WORDS = 9
+FLASH_STORAGE_WORDS = 128
+
+
+def _validate_scene_addr(config: ConfigType) -> ConfigType:
+    slots = config.get(CONF_SCENE_SLOTS, 0)
+    if slots == 0 or not CORE.is_esp8266:
+        return config
+    addr = config[CONF_SCENE_ADDR]
+    if addr + slots * SCENE_RECORD_WORDS > FLASH_STORAGE_WORDS:
+        fit = max(FLASH_STORAGE_WORDS - addr, 0) // SCENE_RECORD_WORDS
+        raise cv.Invalid(
+            f"{slots} scene slots from {CONF_SCENE_ADDR} {addr} don't fit the "
+            f"{FLASH_STORAGE_WORDS} word flash preference area, at most {fit} do.",
+            path=[CONF_SCENE_SLOTS],
+        )
+    return config
+
+
+def _final_validate_scene_addrs() -> None:
+    """Scene slot ranges of different lights must not overlap in flash."""
+    if not CORE.is_esp8266:
+        return
+    ranges = []
+    for light_conf in fv.full_config.get().get("light", []):
+        if slots := light_conf.get(CONF_SCENE_SLOTS, 0):
+            start = light_conf[CONF_SCENE_ADDR]
+            end = start + slots * SCENE_RECORD_WORDS
+            for other_id, other_start, other_end in ranges:
+                if start < other_end and other_start < end:
+                    raise cv.Invalid(
+                        f"Scene slots of '{light_conf[CONF_ID]}' ({start}-{end - 1}) overlap "
+                        f"those of '{other_id}' ({other_start}-{other_end - 1}), set {CONF_SCENE_ADDR}."
+                    )
+            ranges.append((light_conf[CONF_ID], start, end))
+
+
 def _final_validate(config: ConfigType) -> ConfigType:
     """Validate all recorded effect name references against their target lights.
 
     This runs once per light platform instance. If no light platform is configured,
     this never runs — but the ID validator will catch the missing light ID separately.
     """
+    _final_validate_scene_addrs()
+
     data = _get_data()
     if not data.effect_refs and not data.effect_cycle_refs:
         return config
@@ -265,11 +308,17 @@ LIGHT_SCHEMA = (
             cv.Optional(CONF_INITIAL_STATE): LIGHT_STATE_SCHEMA,
             cv.Optional("forced_hash"): cv.int_,
             cv.Optional("forced_addr"): cv.int_,
+            cv.Optional("coalesce_calls", default=False): cv.boolean,
+            cv.Optional("publish_interval"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_SCENE_SLOTS, default=0): cv.int_range(min=0, max=16),
+            cv.Optional(CONF_SCENE_ADDR, default=76): cv.int_range(min=0, max=127),
+            cv.Optional("profile", default=False): cv.boolean,
         }
     )
 )
 
 LIGHT_SCHEMA.add_extra(entity_duplicate_validator("light"))
+LIGHT_SCHEMA.add_extra(_validate_scene_addr)
 
 BINARY_LIGHT_SCHEMA = LIGHT_SCHEMA.extend(
     {
@@ -405,8 +454,8 @@ async def setup_light_core_(light_var, config, output_var):
         cg.add(light_var.set_flash_transition_length(flash_transition_length))
     if (gamma_correct := config.get(CONF_GAMMA_CORRECT)) is not None:
         cg.add(light_var.set_gamma_correct(gamma_correct))
-        fwd_arr = _get_or_create_gamma_table(gamma_correct)
-        cg.add(light_var.set_gamma_table(fwd_arr))
+        fwd_arr, rev_arr, rev8_arr = _get_or_create_gamma_table(gamma_correct)
+        cg.add(light_var.set_gamma_table(fwd_arr, rev_arr, rev8_arr))
         cg.add_define("USE_LIGHT_GAMMA_LUT")
     effects = await cg.build_registry_list(
         EFFECTS_REGISTRY, config.get(CONF_EFFECTS, [])
@@ -443,6 +492,26 @@ async def setup_light_core_(light_var, config, output_var):
     if "forced_addr" in config:
         cg.add(light_var.set_forced_addr(config["forced_addr"]))
 
+    # KAUF: merge bursts of published calls into one call per loop
+    if config["coalesce_calls"]:
+        cg.add(light_var.set_coalesce_calls(True))
+        cg.add_define("USE_LIGHT_COALESCE")
+
+    # KAUF: rate-limit publishes and skip ones where nothing changed
+    if (publish_interval := config.get("publish_interval")) is not None:
+        cg.add(light_var.set_publish_interval(publish_interval))
+        cg.add_define("USE_LIGHT_PUBLISH_SCHEDULER")
+
+    # KAUF: scene slots stored in flash and recalled without validation
+    if config[CONF_SCENE_SLOTS] > 0:
+        cg.add(light_var.set_scene_slots(config[CONF_SCENE_SLOTS]))
+        cg.add(light_var.set_scene_addr(config[CONF_SCENE_ADDR]))
+        cg.add_define("USE_LIGHT_SCENES")
+
+    # KAUF: cycle counter profile of the hot paths, see profile.h.  Without it the scopes compile to nothing.
+    if config["profile"]:
+        cg.add_define("KAUF_PROFILE")
+
 
 async def register_light(output_var, config):
     light_var = cg.new_Pvariable(config[CONF_ID], output_var)
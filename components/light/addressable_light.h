@@ -67,7 +67,7 @@ class AddressableLight : public LightOutput, public Component {
   }
   void setup_state(LightState *state) override {
 #ifdef USE_LIGHT_GAMMA_LUT
-    this->correction_.set_gamma_table(state->get_gamma_table());
+    this->correction_.set_gamma_table(state->get_gamma_table(), state->get_gamma_reverse8_table());
 #endif
     this->state_parent_ = state;
   }
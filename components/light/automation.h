@@ -3,6 +3,7 @@
 #include "esphome/core/automation.h"
 #include "light_state.h"
 #include "addressable_light.h"
+#include "profile.h"
 
 namespace esphome::light {
 
@@ -59,6 +60,18 @@ template<typename... Ts> class LightControlAction final : public Action<Ts...> {
   ApplyFn apply_;
 };
 
+// KAUF: LightControlAction for configs without lambdas.  Codegen emits this instead when every field is a
+// constant, so repeated triggers reuse the last validation (see ConstantLightCall).
+template<typename... Ts> class ConstantLightControlAction final : public Action<Ts...> {
+ public:
+  ConstantLightControlAction(LightState *parent, ConstantLightCall::BuildFn build) : call_(parent, build) {}
+
+  void play(const Ts &...x) override { this->call_.perform(); }
+
+ protected:
+  ConstantLightCall call_;
+};
+
 template<bool HasTransitionLength, typename... Ts> class DimRelativeAction final : public Action<Ts...> {
  public:
   explicit DimRelativeAction(LightState *parent) : parent_(parent) {}
@@ -73,6 +86,9 @@ template<bool HasTransitionLength, typename... Ts> class DimRelativeAction final
     auto call = this->parent_->make_call();
     float rel = this->relative_brightness_.value(x...);
     float cur;
+#ifdef USE_LIGHT_COALESCE
+    this->parent_->flush_coalesced_call();  // KAUF: step from the brightness the last call asked for
+#endif
     this->parent_->remote_values.as_brightness(&cur);
     if ((limit_mode_ == LimitMode::DO_NOTHING) && ((cur < min_brightness_) || (cur > max_brightness_))) {
       return;
@@ -104,6 +120,111 @@ template<bool HasTransitionLength, typename... Ts> class DimRelativeAction final
       transition_length_{};
 };
 
+#ifdef USE_LIGHT_RAMP
+// KAUF: start a constant-rate ramp, e.g. on button press.  One transformer instead of a call per dim step.
+template<typename... Ts> class RampStartAction final : public Action<Ts...> {
+ public:
+  explicit RampStartAction(LightState *parent) : parent_(parent) {}
+
+  TEMPLATABLE_VALUE(float, rate)
+
+  void set_field(LightRampField field) { this->field_ = field; }
+  void set_min_max(float min, float max) {
+    this->min_ = min;
+    this->max_ = max;
+  }
+  void set_limit_mode(LimitMode limit_mode) { this->limit_mode_ = limit_mode; }
+
+  void play(const Ts &...x) override {
+#ifdef USE_LIGHT_COALESCE
+    this->parent_->flush_coalesced_call();  // KAUF: check limits against what the last call asked for
+#endif
+    float cur;
+    if (this->field_ == LightRampField::BRIGHTNESS) {
+      this->parent_->remote_values.as_brightness(&cur);
+    } else {
+      cur = this->parent_->remote_values.get_color_temperature();
+    }
+    if ((this->limit_mode_ == LimitMode::DO_NOTHING) && ((cur < this->min_) || (cur > this->max_))) {
+      return;
+    }
+    this->parent_->start_ramp(this->field_, this->rate_.value(x...), this->min_, this->max_);
+  }
+
+ protected:
+  LightState *parent_;
+  LightRampField field_{LightRampField::BRIGHTNESS};
+  float min_{0.0f};
+  float max_{1.0f};
+  LimitMode limit_mode_{LimitMode::CLAMP};
+};
+
+// KAUF: end a running ramp where it is, e.g. on button release.
+template<typename... Ts> class RampStopAction final : public Action<Ts...> {
+ public:
+  explicit RampStopAction(LightState *parent) : parent_(parent) {}
+
+  void play(const Ts &...x) override { this->parent_->stop_ramp(); }
+
+ protected:
+  LightState *parent_;
+};
+#endif
+
+#ifdef USE_LIGHT_SCENES
+// KAUF: store the light's current target in a scene slot.
+template<typename... Ts> class SceneStoreAction final : public Action<Ts...> {
+ public:
+  explicit SceneStoreAction(LightState *parent) : parent_(parent) {}
+
+  TEMPLATABLE_VALUE(uint8_t, slot)
+
+  void play(const Ts &...x) override { this->parent_->store_scene(this->slot_.value(x...)); }
+
+ protected:
+  LightState *parent_;
+};
+
+// KAUF: go to a stored scene, see LightState::recall_scene().
+template<bool HasTransitionLength, typename... Ts> class SceneRecallAction final : public Action<Ts...> {
+ public:
+  explicit SceneRecallAction(LightState *parent) : parent_(parent) {}
+
+  TEMPLATABLE_VALUE(uint8_t, slot)
+
+  template<typename V> void set_transition_length(V value) requires(HasTransitionLength) {
+    this->transition_length_ = value;
+  }
+
+  void play(const Ts &...x) override {
+    optional<uint32_t> transition_length{};
+    if constexpr (HasTransitionLength) {
+      transition_length = this->transition_length_.optional_value(x...);
+    }
+    this->parent_->recall_scene(this->slot_.value(x...), transition_length);
+  }
+
+ protected:
+  LightState *parent_;
+  struct NoTransition {};
+  [[no_unique_address]] std::conditional_t<HasTransitionLength, TemplatableFn<uint32_t, Ts...>, NoTransition>
+      transition_length_{};
+};
+#endif
+
+#ifdef KAUF_PROFILE
+// KAUF: log the hot path profile, see profile.h.
+template<typename... Ts> class ProfileDumpAction final : public Action<Ts...> {
+ public:
+  explicit ProfileDumpAction(bool reset) : reset_(reset) {}
+
+  void play(const Ts &...x) override { profile_dump(this->reset_); }
+
+ protected:
+  bool reset_;
+};
+#endif
+
 // Cycle through the light's configured effects. `Forward` selects direction
 // at compile time so the chosen branch is the only one that gets instantiated
 // per action site. `include_none` is runtime so a single set of templates
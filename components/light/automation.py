@@ -33,9 +33,11 @@ from esphome.types import ConfigType
 from .types import (
     COLOR_MODES,
     LIMIT_MODES,
+    RAMP_FIELDS,
     AddressableLightState,
     AddressableSet,
     ColorMode,
+    ConstantLightControlAction,
     DimRelativeAction,
     LightCall,
     LightControlAction,
@@ -43,6 +45,11 @@ from .types import (
     LightIsOffCondition,
     LightIsOnCondition,
     LightState,
+    ProfileDumpAction,
+    RampStartAction,
+    RampStopAction,
+    SceneRecallAction,
+    SceneStoreAction,
     ToggleAction,
 )
 
@@ -173,6 +180,43 @@ def _resolve_effect_index(config: ConfigType) -> int:
     )
 
 
+LIGHT_CONTROL_FIELDS = (
+    (CONF_COLOR_MODE, "set_color_mode", ColorMode),
+    (CONF_STATE, "set_state", cg.bool_),
+    (CONF_TRANSITION_LENGTH, "set_transition_length", cg.uint32),
+    (CONF_FLASH_LENGTH, "set_flash_length", cg.uint32),
+    (CONF_BRIGHTNESS, "set_brightness", cg.float_),
+    (CONF_COLOR_BRIGHTNESS, "set_color_brightness", cg.float_),
+    (CONF_RED, "set_red", cg.float_),
+    (CONF_GREEN, "set_green", cg.float_),
+    (CONF_BLUE, "set_blue", cg.float_),
+    (CONF_WHITE, "set_white", cg.float_),
+    (CONF_COLOR_TEMPERATURE, "set_color_temperature", cg.float_),
+    (CONF_COLD_WHITE, "set_cold_white", cg.float_),
+    (CONF_WARM_WHITE, "set_warm_white", cg.float_),
+)
+
+
+async def _constant_light_control_to_code(config, action_id, template_arg, paren):
+    body_lines = [
+        f"call.{setter}({cg.safe_exp(config[conf_key])});"
+        for conf_key, setter, _ in LIGHT_CONTROL_FIELDS
+        if conf_key in config
+    ]
+    if CONF_EFFECT in config:
+        body_lines.append(
+            f"call.set_effect(static_cast<uint32_t>({_resolve_effect_index(config)}));"
+        )
+    build_lambda = LambdaExpression(
+        ["\n".join(body_lines)],
+        [(LightCall.operator("ref"), "call")],
+        capture="",
+        return_type=cg.void,
+    )
+    action_id.type = ConstantLightControlAction
+    return cg.new_Pvariable(action_id, template_arg, paren, build_lambda)
+
+
 @automation.register_action(
     "light.turn_off", LightControlAction, LIGHT_TURN_OFF_ACTION_SCHEMA, synchronous=True
 )
@@ -185,24 +229,15 @@ def _resolve_effect_index(config: ConfigType) -> int:
 async def light_control_to_code(config, action_id, template_arg, args):
     paren = await cg.get_variable(config[CONF_ID])
 
+    # KAUF: without lambdas the call is the same every time, so build it in a
+    # trigger-independent function and let the action reuse its validation.
+    if not any(isinstance(value, Lambda) for value in config.values()):
+        return await _constant_light_control_to_code(
+            config, action_id, template_arg, paren
+        )
+
     # All configured fields are folded into a single stateless lambda whose
     # constants live in flash; the action stores only a function pointer.
-    FIELDS = (
-        (CONF_COLOR_MODE, "set_color_mode", ColorMode),
-        (CONF_STATE, "set_state", cg.bool_),
-        (CONF_TRANSITION_LENGTH, "set_transition_length", cg.uint32),
-        (CONF_FLASH_LENGTH, "set_flash_length", cg.uint32),
-        (CONF_BRIGHTNESS, "set_brightness", cg.float_),
-        (CONF_COLOR_BRIGHTNESS, "set_color_brightness", cg.float_),
-        (CONF_RED, "set_red", cg.float_),
-        (CONF_GREEN, "set_green", cg.float_),
-        (CONF_BLUE, "set_blue", cg.float_),
-        (CONF_WHITE, "set_white", cg.float_),
-        (CONF_COLOR_TEMPERATURE, "set_color_temperature", cg.float_),
-        (CONF_COLD_WHITE, "set_cold_white", cg.float_),
-        (CONF_WARM_WHITE, "set_warm_white", cg.float_),
-    )
-
     # Normalize trigger args to `const std::remove_cvref_t<T> &` so the
     # apply lambda and any inner field lambdas (generated below via
     # `process_lambda`) share one parameter spelling that's well-formed for
@@ -215,7 +250,7 @@ async def light_control_to_code(config, action_id, template_arg, args):
     fwd_args = ", ".join(name for _, name in args)
     body_lines: list[str] = []
 
-    for conf_key, setter, type_ in FIELDS:
+    for conf_key, setter, type_ in LIGHT_CONTROL_FIELDS:
         if conf_key not in config:
             continue
         value = config[conf_key]
@@ -374,6 +409,191 @@ async def light_dim_relative_to_code(config, action_id, template_arg, args):
     return var
 
 
+# KAUF: ramps, for hold-to-dim buttons
+CONF_BRIGHTNESS_RATE = "brightness_rate"
+CONF_COLOR_TEMPERATURE_RATE = "color_temperature_rate"
+CONF_COLOR_TEMPERATURE_LIMITS = "color_temperature_limits"
+CONF_MIN_COLOR_TEMPERATURE = "min_color_temperature"
+CONF_MAX_COLOR_TEMPERATURE = "max_color_temperature"
+
+LIGHT_RAMP_START_ACTION_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Required(CONF_ID): cv.use_id(LightState),
+            # per second, negative to dim / go cooler
+            cv.Optional(CONF_BRIGHTNESS_RATE): cv.templatable(
+                cv.possibly_negative_percentage
+            ),
+            cv.Optional(CONF_COLOR_TEMPERATURE_RATE): cv.templatable(cv.float_),
+            cv.Optional(CONF_BRIGHTNESS_LIMITS): cv.Schema(
+                {
+                    cv.Optional(CONF_MIN_BRIGHTNESS, default="0%"): cv.percentage,
+                    cv.Optional(CONF_MAX_BRIGHTNESS, default="100%"): cv.percentage,
+                    cv.Optional(CONF_LIMIT_MODE, default="CLAMP"): cv.enum(
+                        LIMIT_MODES, upper=True, space="_"
+                    ),
+                }
+            ),
+            cv.Optional(CONF_COLOR_TEMPERATURE_LIMITS): cv.Schema(
+                {
+                    cv.Optional(CONF_MIN_COLOR_TEMPERATURE): cv.color_temperature,
+                    cv.Optional(CONF_MAX_COLOR_TEMPERATURE): cv.color_temperature,
+                    cv.Optional(CONF_LIMIT_MODE, default="CLAMP"): cv.enum(
+                        LIMIT_MODES, upper=True, space="_"
+                    ),
+                }
+            ),
+        }
+    ),
+    cv.has_exactly_one_key(CONF_BRIGHTNESS_RATE, CONF_COLOR_TEMPERATURE_RATE),
+)
+
+
+@automation.register_action(
+    "light.ramp_start",
+    RampStartAction,
+    LIGHT_RAMP_START_ACTION_SCHEMA,
+    synchronous=True,
+)
+async def light_ramp_start_to_code(config, action_id, template_arg, args):
+    cg.add_define("USE_LIGHT_RAMP")
+    paren = await cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, paren)
+    if CONF_BRIGHTNESS_RATE in config:
+        cg.add(var.set_field(RAMP_FIELDS["BRIGHTNESS"]))
+        templ = await cg.templatable(config[CONF_BRIGHTNESS_RATE], args, cg.float_)
+        limits = config.get(CONF_BRIGHTNESS_LIMITS)
+        if limits:
+            cg.add(
+                var.set_min_max(limits[CONF_MIN_BRIGHTNESS], limits[CONF_MAX_BRIGHTNESS])
+            )
+    else:
+        cg.add(var.set_field(RAMP_FIELDS["COLOR_TEMPERATURE"]))
+        templ = await cg.templatable(
+            config[CONF_COLOR_TEMPERATURE_RATE], args, cg.float_
+        )
+        # the light clamps this to its own mired range
+        limits = config.get(CONF_COLOR_TEMPERATURE_LIMITS)
+        cg.add(
+            var.set_min_max(
+                (limits or {}).get(CONF_MIN_COLOR_TEMPERATURE, 0.0),
+                (limits or {}).get(CONF_MAX_COLOR_TEMPERATURE, 1000.0),
+            )
+        )
+    cg.add(var.set_rate(templ))
+    if limits:
+        cg.add(var.set_limit_mode(limits[CONF_LIMIT_MODE]))
+    return var
+
+
+@automation.register_action(
+    "light.ramp_stop",
+    RampStopAction,
+    automation.maybe_simple_id(
+        {
+            cv.Required(CONF_ID): cv.use_id(LightState),
+        }
+    ),
+    synchronous=True,
+)
+async def light_ramp_stop_to_code(config, action_id, template_arg, args):
+    cg.add_define("USE_LIGHT_RAMP")
+    paren = await cg.get_variable(config[CONF_ID])
+    return cg.new_Pvariable(action_id, template_arg, paren)
+
+
+# KAUF: scene slots
+CONF_SLOT = "slot"
+CONF_SCENE_SLOTS = "scene_slots"
+
+
+def _check_scene_slot(config: ConfigType) -> None:
+    """Make sure the target light has scene slots, and a static slot is one of them."""
+    light_id = config[CONF_ID]
+    light_path = CORE.config.get_path_for_id(light_id)[:-1]
+    light_config = CORE.config.get_config_for_path(light_path)
+    slots = light_config.get(CONF_SCENE_SLOTS, 0)
+    if slots == 0:
+        raise EsphomeError(f"Light '{light_id}' has no {CONF_SCENE_SLOTS} configured.")
+    slot = config[CONF_SLOT]
+    if not isinstance(slot, Lambda) and slot >= slots:
+        raise EsphomeError(
+            f"Scene slot {slot} out of range for light '{light_id}' ({slots} slots)."
+        )
+
+
+LIGHT_SCENE_STORE_ACTION_SCHEMA = cv.Schema(
+    {
+        cv.Required(CONF_ID): cv.use_id(LightState),
+        cv.Required(CONF_SLOT): cv.templatable(cv.int_range(min=0, max=255)),
+    }
+)
+LIGHT_SCENE_RECALL_ACTION_SCHEMA = LIGHT_SCENE_STORE_ACTION_SCHEMA.extend(
+    {
+        cv.Optional(CONF_TRANSITION_LENGTH): cv.templatable(
+            cv.positive_time_period_milliseconds
+        ),
+    }
+)
+
+
+@automation.register_action(
+    "light.scene_store",
+    SceneStoreAction,
+    LIGHT_SCENE_STORE_ACTION_SCHEMA,
+    synchronous=True,
+)
+async def light_scene_store_to_code(config, action_id, template_arg, args):
+    _check_scene_slot(config)
+    paren = await cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, paren)
+    templ = await cg.templatable(config[CONF_SLOT], args, cg.uint8)
+    cg.add(var.set_slot(templ))
+    return var
+
+
+@automation.register_action(
+    "light.scene_recall",
+    SceneRecallAction,
+    LIGHT_SCENE_RECALL_ACTION_SCHEMA,
+    synchronous=True,
+)
+async def light_scene_recall_to_code(config, action_id, template_arg, args):
+    _check_scene_slot(config)
+    paren = await cg.get_variable(config[CONF_ID])
+    has_transition_length = CONF_TRANSITION_LENGTH in config
+    recall_template_arg = cg.TemplateArguments(has_transition_length, *template_arg)
+    var = cg.new_Pvariable(action_id, recall_template_arg, paren)
+    templ = await cg.templatable(config[CONF_SLOT], args, cg.uint8)
+    cg.add(var.set_slot(templ))
+    if has_transition_length:
+        templ = await cg.templatable(config[CONF_TRANSITION_LENGTH], args, cg.uint32)
+        cg.add(var.set_transition_length(templ))
+    return var
+
+
+# KAUF: hot path profile, built by profile: true on any light
+CONF_PROFILE = "profile"
+CONF_RESET = "reset"
+
+
+@automation.register_action(
+    "light.profile_dump",
+    ProfileDumpAction,
+    cv.Schema(
+        {
+            cv.Optional(CONF_RESET, default=False): cv.boolean,
+        }
+    ),
+    synchronous=True,
+)
+async def light_profile_dump_to_code(config, action_id, template_arg, args):
+    lights = CORE.config.get("light", [])
+    if not any(conf.get(CONF_PROFILE, False) for conf in lights):
+        raise EsphomeError(f"light.profile_dump needs {CONF_PROFILE}: true on a light.")
+    return cg.new_Pvariable(action_id, template_arg, config[CONF_RESET])
+
+
 LIGHT_ADDRESSABLE_SET_ACTION_SCHEMA = cv.Schema(
     {
         cv.Required(CONF_ID): cv.use_id(AddressableLightState),
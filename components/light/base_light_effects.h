@@ -5,6 +5,8 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/helpers.h"
 #include "light_effect.h"
+#include "light_state.h"
+#include "transformers.h"
 
 namespace esphome::light {
 
@@ -13,27 +15,58 @@ inline static float random_cubic_float() {
   return r * r * r;
 }
 
+/// KAUF: frame interval of the built-in effects that write current_values directly, about one per loop.
+static const uint32_t DIRECT_EFFECT_FRAME_INTERVAL = 16;
+
+/// KAUF: fade stepped by effect frames, in place of a heap-allocated transition per step.  It keeps a
+/// LightTransitionTransformer for its endpoints and interpolation, so frames inside the fade are in the same Tasmota
+/// gamma space as a regular transition and have to be written with write_values_(values, true).
+struct LightEffectFade {
+  LightTransitionTransformer transition;
+  uint32_t start{0};
+  uint32_t length{0};
+  bool active{false};
+
+  void begin(const LightColorValues &from_values, const LightColorValues &to_values, uint32_t now, uint32_t length_ms) {
+    this->transition.setup(from_values, to_values, length_ms);
+    this->start = now;
+    this->length = length_ms;
+    this->active = true;
+  }
+
+  /// Whether now is still inside the fade, i.e. at(now) returns transition values.
+  bool fading(uint32_t now) const { return now - this->start < this->length; }
+
+  LightColorValues at(uint32_t now) {
+    const uint32_t elapsed = now - this->start;
+    if (elapsed >= this->length)
+      return this->transition.get_target_values();
+    return this->transition.values_at(elapsed / float(this->length));
+  }
+};
+
 /// Pulse effect.
 class PulseLightEffect : public LightEffect {
  public:
-  explicit PulseLightEffect(const char *name) : LightEffect(name) {}
+  explicit PulseLightEffect(const char *name) : LightEffect(name) { this->frame_interval_ = DIRECT_EFFECT_FRAME_INTERVAL; }
+
+  void start() override { this->fade_.active = false; }
 
   void apply() override {
     const uint32_t now = millis();
-    if (now - this->last_color_change_ < this->update_interval_) {
-      return;
+    uint32_t period, offset;
+    if (this->sync_period_(this->update_interval_, period, offset)) {
+      // KAUF: clock sync, every bulb fades up on odd periods of the wall clock
+      if (!this->fade_.active || period != this->period_) {
+        this->period_ = period;
+        this->begin_fade_(period & 1, now - offset);
+      }
+    } else if (!this->fade_.active || now - this->last_color_change_ >= this->update_interval_) {
+      this->begin_fade_(this->on_, now);
+      this->on_ = !this->on_;
     }
-    auto call = this->state_->turn_on();
-    float out = this->on_ ? this->max_brightness_ : this->min_brightness_;
-    call.set_brightness_if_supported(out);
-    call.set_transition_length_if_supported(this->on_ ? this->transition_on_length_ : this->transition_off_length_);
-    this->on_ = !this->on_;
     // don't tell HA every change
-    call.set_publish(false);
-    call.set_save(false);
-    call.perform();
-
-    this->last_color_change_ = now;
+    this->write_values_(this->fade_.at(now), this->fade_.fading(now));
   }
 
   void set_transition_on_length(uint32_t transition_length) { this->transition_on_length_ = transition_length; }
@@ -47,8 +80,20 @@ class PulseLightEffect : public LightEffect {
   }
 
  protected:
+  void begin_fade_(bool on, uint32_t start) {
+    LightColorValues target = this->state_->remote_values;
+    target.set_state(true);
+    if (target.get_color_mode() & ColorCapability::BRIGHTNESS)
+      target.set_brightness(on ? this->max_brightness_ : this->min_brightness_);
+    this->fade_.begin(this->state_->current_values, target, start,
+                      on ? this->transition_on_length_ : this->transition_off_length_);
+    this->last_color_change_ = start;
+  }
+
   bool on_ = false;
+  LightEffectFade fade_;
   uint32_t last_color_change_{0};
+  uint32_t period_{0};
   uint32_t transition_on_length_{};
   uint32_t transition_off_length_{};
   uint32_t update_interval_{};
@@ -59,44 +104,56 @@ class PulseLightEffect : public LightEffect {
 /// Random effect. Sets random colors every 10 seconds and slowly transitions between them.
 class RandomLightEffect : public LightEffect {
  public:
-  explicit RandomLightEffect(const char *name) : LightEffect(name) {}
+  explicit RandomLightEffect(const char *name) : LightEffect(name) { this->frame_interval_ = DIRECT_EFFECT_FRAME_INTERVAL; }
+
+  void start() override { this->fade_.active = false; }
 
   void apply() override {
     const uint32_t now = millis();
-    if (now - this->last_color_change_ < this->update_interval_) {
+    // KAUF: with clock sync, colors change on wall clock periods and come from the seed
+    uint32_t period = 0, offset = 0;
+    const bool synced = this->sync_period_(this->update_interval_, period, offset);
+    const bool next = synced ? period != this->period_ : now - this->last_color_change_ >= this->update_interval_;
+    if (this->fade_.active && !next) {
+      this->write_values_(this->fade_.at(now), this->fade_.fading(now));
       return;
     }
+    this->period_ = period;
 
     auto color_mode = this->state_->remote_values.get_color_mode();
     auto call = this->state_->turn_on();
     bool changed = false;
     if (color_mode & ColorCapability::RGB) {
-      call.set_red(random_float());
-      call.set_green(random_float());
-      call.set_blue(random_float());
+      call.set_red(this->effect_random_(synced, period, 0));
+      call.set_green(this->effect_random_(synced, period, 1));
+      call.set_blue(this->effect_random_(synced, period, 2));
       changed = true;
     }
     if (color_mode & ColorCapability::COLOR_TEMPERATURE) {
-      float min = this->state_->get_traits().get_min_mireds();
-      float max = this->state_->get_traits().get_max_mireds();
-      call.set_color_temperature(min + random_float() * (max - min));
+      const auto &traits = this->state_->get_traits();
+      float min = traits.get_min_mireds();
+      float max = traits.get_max_mireds();
+      call.set_color_temperature(min + this->effect_random_(synced, period, 3) * (max - min));
       changed = true;
     }
     if (color_mode & ColorCapability::COLD_WARM_WHITE) {
-      call.set_cold_white(random_float());
-      call.set_warm_white(random_float());
+      call.set_cold_white(this->effect_random_(synced, period, 4));
+      call.set_warm_white(this->effect_random_(synced, period, 5));
       changed = true;
     }
     if (!changed) {
       // only randomize brightness if there's no colored option available
-      call.set_brightness(random_float());
+      call.set_brightness(this->effect_random_(synced, period, 6));
     }
-    call.set_transition_length_if_supported(this->transition_length_);
-    call.set_publish(true);
-    call.set_save(false);
-    call.perform();
+    LightColorValues target = this->validate_call_(call);
 
-    this->last_color_change_ = now;
+    // the new color is shown in HA, but not saved
+    this->state_->remote_values = target;
+    this->state_->publish_state();
+
+    this->fade_.begin(this->state_->current_values, target, now - offset, this->transition_length_);
+    this->write_values_(this->fade_.at(now), this->fade_.fading(now));
+    this->last_color_change_ = now - offset;
   }
 
   void set_transition_length(uint32_t transition_length) { this->transition_length_ = transition_length; }
@@ -104,7 +161,9 @@ class RandomLightEffect : public LightEffect {
   void set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
 
  protected:
+  LightEffectFade fade_;
   uint32_t last_color_change_{0};
+  uint32_t period_{0};
   uint32_t transition_length_{};
   uint32_t update_interval_{};
 };
@@ -162,28 +221,32 @@ struct StrobeLightEffectColor {
 
 class StrobeLightEffect : public LightEffect {
  public:
-  explicit StrobeLightEffect(const char *name) : LightEffect(name) {}
+  explicit StrobeLightEffect(const char *name) : LightEffect(name) { this->frame_interval_ = DIRECT_EFFECT_FRAME_INTERVAL; }
+
+  void start() override { this->fade_.active = false; }
+
   void apply() override {
     const uint32_t now = millis();
-    if (now - this->last_switch_ < this->colors_[this->at_color_].duration)
+    if (this->fade_.active && now - this->last_switch_ < this->colors_[this->at_color_].duration) {
+      this->write_values_(this->fade_.at(now), this->fade_.fading(now));
       return;
+    }
 
     // Switch to next color
     this->at_color_ = (this->at_color_ + 1) % this->colors_.size();
-    auto color = this->colors_[this->at_color_].color;
+    const auto &color = this->colors_[this->at_color_];
 
     auto call = this->state_->turn_on();
-    call.from_light_color_values(this->colors_[this->at_color_].color);
+    call.from_light_color_values(color.color);
 
-    if (!color.is_on()) {
+    if (!color.color.is_on()) {
       // Don't turn the light off, otherwise the light effect will be stopped
       call.set_brightness(0.0f);
       call.set_state(true);
     }
-    call.set_publish(false);
-    call.set_save(false);
-    call.set_transition_length_if_supported(this->colors_[this->at_color_].transition_length);
-    call.perform();
+    // KAUF: validated once per color switch, the frames in between only step the fade
+    this->fade_.begin(this->state_->current_values, this->validate_call_(call), now, color.transition_length);
+    this->write_values_(this->fade_.at(now), this->fade_.fading(now));
     this->last_switch_ = now;
   }
 
@@ -191,18 +254,20 @@ class StrobeLightEffect : public LightEffect {
 
  protected:
   FixedVector<StrobeLightEffectColor> colors_;
+  LightEffectFade fade_;
   uint32_t last_switch_{0};
   size_t at_color_{0};
 };
 
 class FlickerLightEffect : public LightEffect {
  public:
-  explicit FlickerLightEffect(const char *name) : LightEffect(name) {}
+  explicit FlickerLightEffect(const char *name) : LightEffect(name) { this->frame_interval_ = DIRECT_EFFECT_FRAME_INTERVAL; }
 
   void apply() override {
-    LightColorValues remote = this->state_->remote_values;
-    LightColorValues current = this->state_->current_values;
-    LightColorValues out;
+    const LightColorValues &remote = this->state_->remote_values;
+    const LightColorValues &current = this->state_->current_values;
+    // KAUF: start from remote, keeps its color mode, color brightness and color temp
+    LightColorValues out = remote;
     const float alpha = this->alpha_;
     const float beta = 1.0f - alpha;
     out.set_state(true);
@@ -216,17 +281,9 @@ class FlickerLightEffect : public LightEffect {
                        (random_cubic_float() * this->intensity_));
     out.set_warm_white(remote.get_warm_white() * beta + current.get_warm_white() * alpha +
                        (random_cubic_float() * this->intensity_));
+    out.normalize_color();
 
-    // KAUF: restore color temp
-    out.set_color_temperature(remote.get_color_temperature());
-
-    auto call = this->state_->make_call();
-    call.set_publish(false);
-    call.set_save(false);
-    call.set_transition_length_if_supported(0);
-    call.from_light_color_values(out);
-    call.set_state(true);
-    call.perform();
+    this->write_values_(out);
   }
 
   void set_alpha(float alpha) { this->alpha_ = alpha; }
@@ -237,4 +294,162 @@ class FlickerLightEffect : public LightEffect {
   float alpha_{};
 };
 
+/// KAUF: keyframe layout of TimelineLightEffect, packed by effects.py into a PROGMEM uint16 table.
+///   0-1  time in ms, high word first
+///   2    brightness, 0-65535
+///   3-5  red, green, blue, 0-65535
+///   6    color temperature in mireds
+///   7    color (low byte, TimelineColor) | easing into this keyframe (high byte, TimelineEasing)
+static const uint8_t TIMELINE_WORDS = 8;
+
+enum TimelineColor : uint8_t {
+  TIMELINE_COLOR_KEEP = 0,
+  TIMELINE_COLOR_RGB = 1,
+  TIMELINE_COLOR_CT = 2,
+};
+
+enum TimelineEasing : uint8_t {
+  TIMELINE_EASE_LINEAR = 0,
+  TIMELINE_EASE_IN = 1,
+  TIMELINE_EASE_OUT = 2,
+  TIMELINE_EASE_IN_OUT = 3,
+  TIMELINE_EASE_STEP = 4,
+};
+
+enum TimelineMode : uint8_t {
+  TIMELINE_ONCE = 0,
+  TIMELINE_LOOP = 1,
+  TIMELINE_PING_PONG = 2,
+};
+
+/// KAUF: plays a keyframe table from flash. Interpolation is integer (Q15 progress), the only RAM is
+/// the table pointer and playback position, regardless of keyframe count.
+class TimelineLightEffect : public LightEffect {
+ public:
+  explicit TimelineLightEffect(const char *name) : LightEffect(name) {
+    this->frame_interval_ = DIRECT_EFFECT_FRAME_INTERVAL;
+  }
+
+  void start() override {
+    this->start_time_ = millis();
+    this->key_ = 0;
+    const auto &traits = this->state_->get_traits();
+    this->supports_rgb_ = traits.supports_color_capability(ColorCapability::RGB);
+    this->supports_ct_ = traits.supports_color_capability(ColorCapability::COLOR_TEMPERATURE);
+  }
+
+  void apply() override {
+    if (this->count_ == 0)
+      return;
+    uint32_t elapsed = millis() - this->start_time_;
+    // KAUF: with clock sync, looping timelines take their position from the wall clock
+    uint32_t period, offset;
+    if (this->mode_ != TIMELINE_ONCE && this->sync_period_(2 * this->time_(this->count_ - 1), period, offset))
+      elapsed = offset;
+    const uint32_t t = this->position_(elapsed);
+
+    // playback only moves one or two keyframes per frame, so walk from the last segment
+    while (this->key_ + 1 < this->count_ - 1 && this->time_(this->key_ + 1) <= t)
+      this->key_++;
+    while (this->key_ > 0 && this->time_(this->key_) > t)
+      this->key_--;
+
+    const uint16_t a = this->key_;
+    const uint16_t b = this->count_ > 1 ? a + 1 : a;
+    const uint32_t t0 = this->time_(a);
+    const uint32_t t1 = this->time_(b);
+    uint32_t p = 0;
+    if (t1 > t0)
+      p = t >= t1 ? 32768 : uint32_t((uint64_t(t - t0) << 15) / (t1 - t0));
+    else
+      p = 32768;
+    p = ease_(this->word_(b, 7) >> 8, p);
+
+    LightColorValues out = this->state_->remote_values;
+    out.set_state(true);
+    out.set_brightness(lerp_(this->word_(a, 2), this->word_(b, 2), p) / 65535.0f);
+
+    const uint8_t color_a = this->word_(a, 7) & 0xFF;
+    const uint8_t color_b = this->word_(b, 7) & 0xFF;
+    // across a color mode change only brightness is interpolated, the color snaps to the target
+    const uint32_t cp = color_a == color_b ? p : 32768;
+    if (color_b == TIMELINE_COLOR_RGB && this->supports_rgb_) {
+      out.set_color_mode(out.get_color_mode() & ColorCapability::RGB ? out.get_color_mode() : ColorMode::RGB);
+      out.set_color_brightness(1.0f);
+      out.set_red(lerp_(this->word_(a, 3), this->word_(b, 3), cp) / 65535.0f);
+      out.set_green(lerp_(this->word_(a, 4), this->word_(b, 4), cp) / 65535.0f);
+      out.set_blue(lerp_(this->word_(a, 5), this->word_(b, 5), cp) / 65535.0f);
+      out.normalize_color();
+    } else if (color_b == TIMELINE_COLOR_CT && this->supports_ct_) {
+      if (!(out.get_color_mode() & ColorCapability::COLOR_TEMPERATURE))
+        out.set_color_mode(ColorMode::COLOR_TEMPERATURE);
+      out.set_color_temperature(lerp_(this->word_(a, 6), this->word_(b, 6), cp));
+    }
+
+    this->write_values_(out);
+  }
+
+  void set_keyframes(const uint16_t *table, uint16_t count) {
+    this->table_ = table;
+    this->count_ = count;
+  }
+  void set_mode(TimelineMode mode) { this->mode_ = mode; }
+
+ protected:
+  uint16_t word_(uint16_t key, uint8_t word) const {
+    return progmem_read_uint16(&this->table_[key * TIMELINE_WORDS + word]);
+  }
+  uint32_t time_(uint16_t key) const { return (uint32_t(this->word_(key, 0)) << 16) | this->word_(key, 1); }
+
+  /// Map time since start onto the timeline according to the playback mode.
+  uint32_t position_(uint32_t elapsed) const {
+    const uint32_t duration = this->time_(this->count_ - 1);
+    if (duration == 0)
+      return 0;
+    switch (this->mode_) {
+      case TIMELINE_LOOP:
+        return elapsed % duration;
+      case TIMELINE_PING_PONG: {
+        const uint32_t pos = elapsed % (2 * duration);
+        return pos < duration ? pos : 2 * duration - pos;
+      }
+      case TIMELINE_ONCE:
+      default:
+        return elapsed < duration ? elapsed : duration;
+    }
+  }
+
+  /// Progress p is Q15, 0 to 32768.
+  static uint32_t ease_(uint8_t easing, uint32_t p) {
+    switch (easing) {
+      case TIMELINE_EASE_IN:
+        return (p * p) >> 15;
+      case TIMELINE_EASE_OUT: {
+        const uint32_t q = 32768 - p;
+        return 32768 - ((q * q) >> 15);
+      }
+      case TIMELINE_EASE_IN_OUT:
+        // smoothstep, p^2 * (3 - 2p)
+        return (((p * p) >> 15) * (3 * 32768 - 2 * p)) >> 15;
+      case TIMELINE_EASE_STEP:
+        return p < 32768 ? 0 : 32768;
+      case TIMELINE_EASE_LINEAR:
+      default:
+        return p;
+    }
+  }
+
+  static uint16_t lerp_(uint16_t a, uint16_t b, uint32_t p) {
+    return a + ((int32_t(b) - int32_t(a)) * int32_t(p)) / 32768;
+  }
+
+  const uint16_t *table_{nullptr};
+  uint32_t start_time_{0};
+  uint16_t count_{0};
+  uint16_t key_{0};
+  TimelineMode mode_{TIMELINE_ONCE};
+  bool supports_rgb_{false};
+  bool supports_ct_{false};
+};
+
 }  // namespace esphome::light
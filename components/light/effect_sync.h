@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome::light {
+
+// KAUF: the wall clock math behind clock synced effects (LightEffect::sync_period_() / effect_random_()).  No ESPHome
+// dependencies, so tests/effect_sync_test.cpp can run two bulbs against it on the host.
+
+/// Index of the interval-long period of the wall clock that now_ms (ms since the epoch) is in, and ms into it.
+inline void effect_sync_period(uint64_t now_ms, uint32_t interval, uint32_t &period, uint32_t &offset) {
+  period = now_ms / interval;
+  offset = now_ms % interval;
+}
+
+/// Random value in [0, 1) from seed, period and draw n alone, so a bulb that starts late lands on the same sequence.
+inline float effect_sync_random(uint32_t seed, uint32_t period, uint8_t n) {
+  // splitmix32 finalizer
+  uint32_t x = seed + period * 0x9E3779B9u + n * 0x85EBCA6Bu;
+  x ^= x >> 16;
+  x *= 0x7FEB352Du;
+  x ^= x >> 15;
+  x *= 0x846CA68Bu;
+  x ^= x >> 16;
+  return (x >> 8) / 16777216.0f;
+}
+
+}  // namespace esphome::light
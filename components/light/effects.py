@@ -16,6 +16,7 @@ from esphome.const import (
     CONF_LAMBDA,
     CONF_MAX_BRIGHTNESS,
     CONF_MIN_BRIGHTNESS,
+    CONF_MODE,
     CONF_NAME,
     CONF_NUM_LEDS,
     CONF_RANDOM,
@@ -23,18 +24,21 @@ from esphome.const import (
     CONF_SEQUENCE,
     CONF_SPEED,
     CONF_STATE,
+    CONF_TIME,
     CONF_TRANSITION_LENGTH,
     CONF_UPDATE_INTERVAL,
     CONF_WARM_WHITE,
     CONF_WHITE,
     CONF_WIDTH,
 )
+from esphome.core import ID, HexInt
 from esphome.cpp_generator import MockObjClass
 from esphome.schema_extractors import SCHEMA_EXTRACT, schema_extractor
 from esphome.util import Registry
 
 from .types import (
     COLOR_MODES,
+    TIMELINE_MODES,
     AddressableColorWipeEffect,
     AddressableColorWipeEffectColor,
     AddressableFireworksEffect,
@@ -56,6 +60,7 @@ from .types import (
     RandomLightEffect,
     StrobeLightEffect,
     StrobeLightEffectColor,
+    TimelineLightEffect,
 )
 
 CONF_ADD_LED_INTERVAL = "add_led_interval"
@@ -81,6 +86,33 @@ CONF_ADDRESSABLE_FLICKER = "addressable_flicker"
 CONF_AUTOMATION = "automation"
 CONF_ON_LENGTH = "on_length"
 CONF_OFF_LENGTH = "off_length"
+CONF_TIMELINE = "timeline"
+CONF_KEYFRAMES = "keyframes"
+CONF_EASING = "easing"
+CONF_CLOCK_SYNC = "clock_sync"
+CONF_SEED = "seed"
+
+# KAUF: phase from the wall clock, randomness from seed, needs a time: component to set the clock
+CLOCK_SYNC_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Optional(CONF_SEED, default=0): cv.uint32_t,
+        }
+    ),
+    cv.requires_component("time"),
+)
+
+# KAUF: must match TimelineColor / TimelineEasing in base_light_effects.h
+TIMELINE_COLOR_KEEP = 0
+TIMELINE_COLOR_RGB = 1
+TIMELINE_COLOR_CT = 2
+TIMELINE_EASINGS = {
+    "LINEAR": 0,
+    "EASE_IN": 1,
+    "EASE_OUT": 2,
+    "EASE_IN_OUT": 3,
+    "STEP": 4,
+}
 
 BINARY_EFFECTS = []
 MONOCHROMATIC_EFFECTS = []
@@ -165,6 +197,12 @@ def register_addressable_effect(
     return register_effect(name, effect_type, default_name, schema, *extra_validators)
 
 
+def _clock_sync_to_code(config, effect):
+    if sync := config.get(CONF_CLOCK_SYNC):
+        cg.add_define("USE_LIGHT_EFFECT_SYNC")
+        cg.add(effect.set_clock_sync(sync[CONF_SEED]))
+
+
 @register_binary_effect(
     "lambda",
     LambdaLightEffect,
@@ -218,6 +256,7 @@ async def automation_effect_to_code(config, effect_id):
         ): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_MIN_BRIGHTNESS, default="0%"): cv.percentage,
         cv.Optional(CONF_MAX_BRIGHTNESS, default="100%"): cv.percentage,
+        cv.Optional(CONF_CLOCK_SYNC): CLOCK_SYNC_SCHEMA,
     },
 )
 async def pulse_effect_to_code(config, effect_id):
@@ -243,6 +282,7 @@ async def pulse_effect_to_code(config, effect_id):
             config[CONF_MIN_BRIGHTNESS], config[CONF_MAX_BRIGHTNESS]
         )
     )
+    _clock_sync_to_code(config, effect)
     return effect
 
 
@@ -257,12 +297,14 @@ async def pulse_effect_to_code(config, effect_id):
         cv.Optional(
             CONF_UPDATE_INTERVAL, default="10s"
         ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_CLOCK_SYNC): CLOCK_SYNC_SCHEMA,
     },
 )
 async def random_effect_to_code(config, effect_id):
     effect = cg.new_Pvariable(effect_id, config[CONF_NAME])
     cg.add(effect.set_transition_length(config[CONF_TRANSITION_LENGTH]))
     cg.add(effect.set_update_interval(config[CONF_UPDATE_INTERVAL]))
+    _clock_sync_to_code(config, effect)
     return effect
 
 
@@ -366,6 +408,103 @@ async def flicker_effect_to_code(config, effect_id):
     return var
 
 
+def _validate_timeline_keyframes(value):
+    if value[0][CONF_TIME].total_milliseconds != 0:
+        raise cv.Invalid("The first keyframe must be at time 0", [0, CONF_TIME])
+    for i in range(1, len(value)):
+        if (
+            value[i][CONF_TIME].total_milliseconds
+            <= value[i - 1][CONF_TIME].total_milliseconds
+        ):
+            raise cv.Invalid(
+                "Keyframe times must be strictly increasing", [i, CONF_TIME]
+            )
+    if value[-1][CONF_TIME].total_milliseconds > 0xFFFFFFFF:
+        raise cv.Invalid("Timeline is too long", [len(value) - 1, CONF_TIME])
+    return value
+
+
+def _pack_timeline_keyframes(keyframes):
+    """Pack keyframes into TIMELINE_WORDS uint16 words each, see TimelineLightEffect.
+
+    A keyframe without a color keeps the color of the previous one.
+    """
+    words = []
+    color = (TIMELINE_COLOR_KEEP, 0, 0, 0, 0)
+    for key in keyframes:
+        if CONF_RED in key:
+            color = (
+                TIMELINE_COLOR_RGB,
+                int(round(key[CONF_RED] * 65535)),
+                int(round(key[CONF_GREEN] * 65535)),
+                int(round(key[CONF_BLUE] * 65535)),
+                0,
+            )
+        elif CONF_COLOR_TEMPERATURE in key:
+            color = (
+                TIMELINE_COLOR_CT,
+                0,
+                0,
+                0,
+                int(round(key[CONF_COLOR_TEMPERATURE])),
+            )
+        time_ms = key[CONF_TIME].total_milliseconds
+        words += [
+            HexInt(time_ms >> 16),
+            HexInt(time_ms & 0xFFFF),
+            int(round(key[CONF_BRIGHTNESS] * 65535)),
+            color[1],
+            color[2],
+            color[3],
+            color[4],
+            HexInt((TIMELINE_EASINGS[key[CONF_EASING]] << 8) | color[0]),
+        ]
+    return words
+
+
+@register_monochromatic_effect(
+    CONF_TIMELINE,
+    TimelineLightEffect,
+    "Timeline",
+    {
+        cv.Optional(CONF_MODE, default="LOOP"): cv.enum(
+            TIMELINE_MODES, upper=True, space="_"
+        ),
+        cv.Required(CONF_KEYFRAMES): cv.All(
+            cv.ensure_list(
+                cv.Schema(
+                    {
+                        cv.Required(CONF_TIME): cv.positive_time_period_milliseconds,
+                        cv.Optional(CONF_BRIGHTNESS, default=1.0): cv.percentage,
+                        cv.Optional(CONF_RED): cv.percentage,
+                        cv.Optional(CONF_GREEN): cv.percentage,
+                        cv.Optional(CONF_BLUE): cv.percentage,
+                        cv.Optional(CONF_COLOR_TEMPERATURE): cv.color_temperature,
+                        cv.Optional(CONF_EASING, default="LINEAR"): cv.enum(
+                            TIMELINE_EASINGS, upper=True, space="_"
+                        ),
+                    }
+                ),
+                cv.has_none_or_all_keys(CONF_RED, CONF_GREEN, CONF_BLUE),
+                cv.has_at_most_one_key(CONF_RED, CONF_COLOR_TEMPERATURE),
+            ),
+            cv.Length(min=2, max=0xFFFF),
+            _validate_timeline_keyframes,
+        ),
+        cv.Optional(CONF_CLOCK_SYNC): CLOCK_SYNC_SCHEMA,
+    },
+)
+async def timeline_effect_to_code(config, effect_id):
+    var = cg.new_Pvariable(effect_id, config[CONF_NAME])
+    keyframes = config[CONF_KEYFRAMES]
+    table_id = ID(f"{effect_id.id}_keyframes", is_declaration=True, type=cg.uint16)
+    table = cg.progmem_array(table_id, _pack_timeline_keyframes(keyframes))
+    cg.add(var.set_keyframes(table, len(keyframes)))
+    cg.add(var.set_mode(config[CONF_MODE]))
+    _clock_sync_to_code(config, var)
+    return var
+
+
 @register_addressable_effect(
     "addressable_lambda",
     AddressableLambdaLightEffect,
@@ -9,17 +9,9 @@ uint8_t ESPColorCorrection::gamma_correct_(uint8_t value) const {
 }
 
 uint8_t ESPColorCorrection::gamma_uncorrect_(uint8_t value) const {
-  if (this->gamma_table_ == nullptr)
+  if (this->gamma_reverse8_table_ == nullptr)
     return value;
-  if (value == 0)
-    return 0;
-  uint16_t target = value * 257;  // Scale 0-255 to 0-65535
-  uint8_t lo = gamma_table_reverse_search(this->gamma_table_, target);
-  if (lo >= 255)
-    return 255;
-  uint16_t a = progmem_read_uint16(&this->gamma_table_[lo]);
-  uint16_t b = progmem_read_uint16(&this->gamma_table_[lo + 1]);
-  return (target - a <= b - target) ? lo : lo + 1;
+  return progmem_read_byte(&this->gamma_reverse8_table_[value]);
 }
 
 Color ESPColorCorrection::color_uncorrect(Color color) const {
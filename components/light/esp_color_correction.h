@@ -24,7 +24,10 @@ class ESPColorCorrection {
  public:
   void set_max_brightness(const Color &max_brightness) { this->max_brightness_ = max_brightness; }
   void set_local_brightness(uint8_t local_brightness) { this->local_brightness_ = local_brightness; }
-  void set_gamma_table(const uint16_t *table) { this->gamma_table_ = table; }
+  void set_gamma_table(const uint16_t *table, const uint8_t *reverse8) {
+    this->gamma_table_ = table;
+    this->gamma_reverse8_table_ = reverse8;
+  }
   inline Color color_correct(Color color) const ESPHOME_ALWAYS_INLINE {
     // corrected = (uncorrected * max_brightness * local_brightness) ^ gamma
     return Color(this->color_correct_red(color.red), this->color_correct_green(color.green),
@@ -63,13 +66,14 @@ class ESPColorCorrection {
  protected:
   /// Forward gamma: read uint16 PROGMEM table, convert to uint8
   uint8_t gamma_correct_(uint8_t value) const;
-  /// Reverse gamma: binary search the forward PROGMEM table
+  /// Reverse gamma: read uint8 reverse PROGMEM table
   uint8_t gamma_uncorrect_(uint8_t value) const;
   /// Shared body of color_uncorrect_{red,green,blue,white}. Kept out-of-line
   /// to avoid duplicating two 16-bit divides at every call site.
   uint8_t color_uncorrect_channel_(uint8_t value, uint8_t max_brightness) const;
 
   const uint16_t *gamma_table_{nullptr};
+  const uint8_t *gamma_reverse8_table_{nullptr};
   Color max_brightness_{255, 255, 255, 255};
   uint8_t local_brightness_{255};
 };
@@ -0,0 +1,47 @@
+"""Gamma lookup tables for the light component, plain Python so they can be tested without ESPHome."""
+
+from bisect import bisect_right
+
+
+def gamma_table(gamma_correct: float) -> list[int]:
+    """Generate a 256-entry uint16 gamma lookup table.
+
+    For gamma > 0, non-zero indices are clamped to a minimum of 1 to preserve
+    the invariant that non-zero input always produces non-zero output. Without
+    this, small brightness values (e.g. 1%) get quantized to exactly 0.0,
+    which breaks zero_means_zero logic in FloatOutput.
+    """
+    if gamma_correct > 0:
+        return [
+            max(1, min(65535, int(round((i / 255.0) ** gamma_correct * 65535))))
+            if i > 0
+            else 0
+            for i in range(256)
+        ]
+    return [int(round(i / 255.0 * 65535)) for i in range(256)]
+
+
+def gamma_reverse_tables(forward: list[int]) -> tuple[list[int], list[int]]:
+    """KAUF: generate the 256-entry reverse tables of a forward gamma table.
+
+    Both are indexed by the gamma corrected value in 0-255 (target = index * 257).
+    The uint16 table holds the uncorrected value in 0-65535, interpolated between
+    forward entries. The uint8 table holds the nearest forward index, same as a
+    search of the forward table would give.
+    """
+    fwd = [int(x) for x in forward]
+    reverse = []
+    reverse8 = []
+    for i in range(256):
+        target = i * 257
+        # largest index with fwd[lo] <= target
+        lo = bisect_right(fwd, target) - 1
+        if lo >= 255:
+            reverse.append(65535)
+            reverse8.append(255)
+            continue
+        a, b = fwd[lo], fwd[lo + 1]
+        frac = 0.0 if b == a else (target - a) / (b - a)
+        reverse.append(int(round((lo + frac) / 255.0 * 65535)))
+        reverse8.append(lo if target - a <= b - target else lo + 1)
+    return reverse, reverse8
@@ -0,0 +1,342 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace esphome::light {
+
+// KAUF: single pass reader for the light JSON commands Home Assistant sends, tried by LightJSONSchema::parse_json()
+// before ArduinoJson.  It only takes one object of known keys ("color" holding r/g/b/c/w) with unsigned integer or
+// plain string values.  Anything else (unknown or duplicate keys, signs, fractions, exponents, literals, escapes,
+// nested values, invalid JSON) makes parse_json_command() return false, and the text goes to ArduinoJson instead.
+// No ESPHome dependencies, so tests/json_command_test.py fuzzes it against the ArduinoJson path on the host.
+
+struct JsonCommand {
+  // keys, also bits of seen to catch duplicates
+  enum Key : uint16_t {
+    STATE = 1 << 0,
+    BRIGHTNESS = 1 << 1,
+    COLOR = 1 << 2,
+    WHITE_VALUE = 1 << 3,
+    COLOR_TEMP = 1 << 4,
+    FLASH = 1 << 5,
+    TRANSITION = 1 << 6,
+    EFFECT = 1 << 7,
+    EFFECT_INDEX = 1 << 8,
+    R = 1 << 9,
+    G = 1 << 10,
+    B = 1 << 11,
+    C = 1 << 12,
+    W = 1 << 13,
+  };
+  static constexpr uint8_t KEYS = 14;
+
+  struct Value {
+    enum Type : uint8_t { NONE, UINT, STRING } type{NONE};
+    uint32_t number{0};
+    const char *str{nullptr};
+    size_t str_len{0};
+
+    /// ArduinoJson's is<T>() for an unsigned T with this max
+    bool is_uint(uint32_t max) const { return this->type == UINT && this->number <= max; }
+    bool is_string() const { return this->type == STRING; }
+  };
+
+  Value values[KEYS];
+  uint16_t seen{0};
+
+  const Value &get(Key key) const { return this->values[__builtin_ctz(key)]; }
+};
+
+namespace json_command {
+
+struct Reader {
+  const char *pos;
+  const char *end;
+
+  void skip_ws() {
+    while (this->pos < this->end &&
+           (*this->pos == ' ' || *this->pos == '\t' || *this->pos == '\n' || *this->pos == '\r'))
+      this->pos++;
+  }
+  bool consume(char c) {
+    this->skip_ws();
+    if (this->pos >= this->end || *this->pos != c)
+      return false;
+    this->pos++;
+    return true;
+  }
+  bool peek(char c) {
+    this->skip_ws();
+    return this->pos < this->end && *this->pos == c;
+  }
+
+  // plain strings only, escapes go to ArduinoJson
+  bool string(const char **str, size_t *len) {
+    if (!this->consume('"'))
+      return false;
+    const char *start = this->pos;
+    while (this->pos < this->end && *this->pos != '"') {
+      if (*this->pos == '\\' || static_cast<uint8_t>(*this->pos) < 0x20)
+        return false;
+      this->pos++;
+    }
+    if (this->pos >= this->end)
+      return false;
+    *str = start;
+    *len = this->pos - start;
+    this->pos++;
+    return true;
+  }
+
+  // unsigned integers up to UINT32_MAX only, no leading zeros (invalid JSON)
+  bool number(uint32_t *value) {
+    const char *digits = this->pos;
+    uint64_t acc = 0;
+    while (this->pos < this->end && *this->pos >= '0' && *this->pos <= '9') {
+      acc = acc * 10 + (*this->pos - '0');
+      if (acc > UINT32_MAX)
+        return false;
+      this->pos++;
+    }
+    const size_t len = this->pos - digits;
+    if (len == 0 || (len > 1 && *digits == '0'))
+      return false;
+    // fraction or exponent
+    if (this->pos < this->end && (*this->pos == '.' || *this->pos == 'e' || *this->pos == 'E'))
+      return false;
+    *value = uint32_t(acc);
+    return true;
+  }
+
+  bool value(JsonCommand::Value *value) {
+    this->skip_ws();
+    if (this->pos >= this->end)
+      return false;
+    if (*this->pos == '"') {
+      value->type = JsonCommand::Value::STRING;
+      return this->string(&value->str, &value->str_len);
+    }
+    value->type = JsonCommand::Value::UINT;
+    return this->number(&value->number);
+  }
+};
+
+inline uint16_t key_of(const char *key, size_t len) {
+  switch (len) {
+    case 5:
+      if (memcmp(key, "state", 5) == 0)
+        return JsonCommand::STATE;
+      if (memcmp(key, "color", 5) == 0)
+        return JsonCommand::COLOR;
+      if (memcmp(key, "flash", 5) == 0)
+        return JsonCommand::FLASH;
+      break;
+    case 6:
+      if (memcmp(key, "effect", 6) == 0)
+        return JsonCommand::EFFECT;
+      break;
+    case 10:
+      if (memcmp(key, "brightness", 10) == 0)
+        return JsonCommand::BRIGHTNESS;
+      if (memcmp(key, "color_temp", 10) == 0)
+        return JsonCommand::COLOR_TEMP;
+      if (memcmp(key, "transition", 10) == 0)
+        return JsonCommand::TRANSITION;
+      break;
+    case 11:
+      if (memcmp(key, "white_value", 11) == 0)
+        return JsonCommand::WHITE_VALUE;
+      break;
+    case 12:
+      if (memcmp(key, "effect_index", 12) == 0)
+        return JsonCommand::EFFECT_INDEX;
+      break;
+  }
+  return 0;
+}
+
+inline uint16_t color_key_of(const char *key, size_t len) {
+  if (len != 1)
+    return 0;
+  switch (key[0]) {
+    case 'r':
+      return JsonCommand::R;
+    case 'g':
+      return JsonCommand::G;
+    case 'b':
+      return JsonCommand::B;
+    case 'c':
+      return JsonCommand::C;
+    case 'w':
+      return JsonCommand::W;
+    default:
+      return 0;
+  }
+}
+
+// parse_on_off(): case insensitive "on", "off" or "toggle"
+enum OnOff : uint8_t { ON_OFF_NONE, ON_OFF_ON, ON_OFF_OFF, ON_OFF_TOGGLE };
+
+inline bool equals_ignore_case(const char *str, size_t len, const char *word) {
+  for (size_t i = 0; i < len; i++) {
+    char c = str[i];
+    if (c >= 'A' && c <= 'Z')
+      c = char(c - 'A' + 'a');
+    if (c != word[i])
+      return false;
+  }
+  return word[len] == '\0';
+}
+
+inline OnOff on_off(const char *str, size_t len) {
+  if (equals_ignore_case(str, len, "on"))
+    return ON_OFF_ON;
+  if (equals_ignore_case(str, len, "off"))
+    return ON_OFF_OFF;
+  if (equals_ignore_case(str, len, "toggle"))
+    return ON_OFF_TOGGLE;
+  return ON_OFF_NONE;
+}
+
+}  // namespace json_command
+
+/// Read data (len bytes, no terminator needed) into cmd.  False if it isn't a command this reader takes.
+inline bool parse_json_command(const char *data, size_t len, JsonCommand &cmd) {
+  json_command::Reader p{data, data + len};
+  cmd.seen = 0;
+
+  auto read_member = [&](uint16_t key) -> bool {
+    if (key == 0 || (cmd.seen & key))
+      return false;
+    cmd.seen |= key;
+    return p.consume(':') && p.value(&cmd.values[__builtin_ctz(key)]);
+  };
+
+  if (!p.consume('{'))
+    return false;
+  if (!p.peek('}')) {
+    do {
+      const char *key;
+      size_t key_len;
+      if (!p.string(&key, &key_len))
+        return false;
+      const uint16_t k = json_command::key_of(key, key_len);
+      if (k == JsonCommand::COLOR) {
+        if (cmd.seen & JsonCommand::COLOR)
+          return false;
+        cmd.seen |= JsonCommand::COLOR;
+        if (!p.consume(':') || !p.consume('{'))
+          return false;
+        if (!p.peek('}')) {
+          do {
+            if (!p.string(&key, &key_len) || !read_member(json_command::color_key_of(key, key_len)))
+              return false;
+          } while (p.consume(','));
+        }
+        if (!p.consume('}'))
+          return false;
+      } else if (!read_member(k)) {
+        return false;
+      }
+    } while (p.consume(','));
+  }
+  if (!p.consume('}'))
+    return false;
+  p.skip_ws();
+  if (p.pos != p.end)
+    return false;
+
+  for (uint8_t i = 0; i < JsonCommand::KEYS; i++) {
+    if (!(cmd.seen & (1u << i)))
+      cmd.values[i].type = JsonCommand::Value::NONE;
+  }
+  return true;
+}
+
+/** Set up call from cmd with the same rules and order as LightJSONSchema::parse_color_json() + parse_json().
+ *
+ * Call is LightCall, or a recording stand-in on the host.  is_on is the light's remote state, for "toggle".
+ */
+template<typename Call> void apply_json_command(const JsonCommand &cmd, Call &call, bool is_on) {
+  using Key = JsonCommand::Key;
+
+  const auto &state = cmd.get(Key::STATE);
+  if (state.is_string()) {
+    switch (json_command::on_off(state.str, state.str_len)) {
+      case json_command::ON_OFF_ON:
+        call.set_state(true);
+        break;
+      case json_command::ON_OFF_OFF:
+        call.set_state(false);
+        break;
+      case json_command::ON_OFF_TOGGLE:
+        call.set_state(!is_on);
+        break;
+      case json_command::ON_OFF_NONE:
+        break;
+    }
+  }
+
+  if (cmd.get(Key::BRIGHTNESS).is_uint(255))
+    call.set_brightness(float(cmd.get(Key::BRIGHTNESS).number) / 255.0f);
+
+  // HA also encodes brightness information in the r, g, b values, so extract that and set it as color brightness.
+  float max_rgb = 0.0f;
+  bool has_rgb = false;
+  if (cmd.get(Key::R).is_uint(255)) {
+    float r = float(cmd.get(Key::R).number) / 255.0f;
+    max_rgb = fmaxf(max_rgb, r);
+    call.set_red(r);
+    has_rgb = true;
+  }
+  if (cmd.get(Key::G).is_uint(255)) {
+    float g = float(cmd.get(Key::G).number) / 255.0f;
+    max_rgb = fmaxf(max_rgb, g);
+    call.set_green(g);
+    has_rgb = true;
+  }
+  if (cmd.get(Key::B).is_uint(255)) {
+    float b = float(cmd.get(Key::B).number) / 255.0f;
+    max_rgb = fmaxf(max_rgb, b);
+    call.set_blue(b);
+    has_rgb = true;
+  }
+  if (has_rgb)
+    call.set_color_brightness(max_rgb);
+
+  const bool has_c = cmd.get(Key::C).is_uint(255);
+  if (has_c)
+    call.set_cold_white(float(cmd.get(Key::C).number) / 255.0f);
+  if (cmd.get(Key::W).is_uint(255)) {
+    // same ambiguity as parse_color_json(): "w" is warm white when "c" is present, white otherwise
+    if (has_c) {
+      call.set_warm_white(float(cmd.get(Key::W).number) / 255.0f);
+    } else {
+      call.set_white(float(cmd.get(Key::W).number) / 255.0f);
+    }
+  }
+
+  if (cmd.get(Key::WHITE_VALUE).is_uint(255))  // legacy API
+    call.set_white(float(cmd.get(Key::WHITE_VALUE).number) / 255.0f);
+
+  if (cmd.get(Key::COLOR_TEMP).is_uint(UINT16_MAX))
+    call.set_color_temperature(float(cmd.get(Key::COLOR_TEMP).number));
+
+  if (cmd.get(Key::FLASH).is_uint(UINT32_MAX))
+    call.set_flash_length(uint32_t(float(cmd.get(Key::FLASH).number) * 1000));
+
+  if (cmd.get(Key::TRANSITION).is_uint(UINT16_MAX))
+    call.set_transition_length(uint32_t(float(cmd.get(Key::TRANSITION).number) * 1000));
+
+  const auto &effect = cmd.get(Key::EFFECT);
+  if (effect.is_string())
+    call.set_effect(effect.str, effect.str_len);
+
+  if (cmd.get(Key::EFFECT_INDEX).is_uint(UINT32_MAX))
+    call.set_effect(cmd.get(Key::EFFECT_INDEX).number);
+}
+
+}  // namespace esphome::light
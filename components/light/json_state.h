@@ -0,0 +1,242 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#ifdef USE_ESP8266
+#include <pgmspace.h>
+#endif
+
+namespace esphome::light {
+
+// KAUF: the light's JSON state as the values that go into it, worked out once per remote values change and shared by
+// every reader.  LightJSONSchema::dump_json() (web_server SSE and REST, MQTT state) copies them into the caller's
+// document, get_cached_json() (kauf_udp_control) keeps their text.  No ESPHome dependencies, so
+// tests/json_state_test.cpp checks the encoder and measures the cache on the host.
+
+struct JsonState {
+  enum Flag : uint8_t {
+    HAS_EFFECTS = 1 << 0,
+    HAS_STATE = 1 << 1,
+    STATE_ON = 1 << 2,
+    HAS_BRIGHTNESS = 1 << 3,
+    HAS_WHITE = 1 << 4,
+    HAS_CWWW = 1 << 5,
+  };
+
+  const char *effect{nullptr};  // null terminated, lives as long as the effect
+  uint16_t effect_len{0};
+  uint32_t effect_index{0};
+  uint32_t effect_count{0};
+  const char *color_mode{nullptr};  // PROGMEM on ESP8266, nullptr if unknown
+  uint32_t color_temp{0};
+  uint8_t flags{0};
+  uint8_t brightness{0};
+  uint8_t red{0};
+  uint8_t green{0};
+  uint8_t blue{0};
+  uint8_t white{0};
+  uint8_t cold_white{0};
+  uint8_t warm_white{0};
+
+  bool has(Flag flag) const { return this->flags & flag; }
+};
+
+namespace json_state {
+
+// minimal append-only writer, sets overflow instead of writing past the end
+struct Writer {
+  char *buf;
+  size_t size;
+  size_t pos{0};
+  bool overflow{false};
+
+  void raw(const char *str, size_t len) {
+    if (this->overflow || this->pos + len >= this->size) {
+      this->overflow = true;
+      return;
+    }
+    memcpy(this->buf + this->pos, str, len);
+    this->pos += len;
+  }
+  void raw(const char *str) { this->raw(str, strlen(str)); }
+  void raw(char c) { this->raw(&c, 1); }
+
+  void progmem(const char *str) {
+#ifdef USE_ESP8266
+    size_t len = strlen_P(str);
+    if (this->overflow || this->pos + len >= this->size) {
+      this->overflow = true;
+      return;
+    }
+    memcpy_P(this->buf + this->pos, str, len);
+    this->pos += len;
+#else
+    this->raw(str);
+#endif
+  }
+
+  void uint(uint32_t value) {
+    char tmp[10];
+    size_t len = 0;
+    do {
+      tmp[len++] = char('0' + value % 10);
+      value /= 10;
+    } while (value != 0);
+    while (len > 0)
+      this->raw(tmp[--len]);
+  }
+
+  void string(const char *str, size_t len) {
+    this->raw('"');
+    for (size_t i = 0; i < len; i++) {
+      const char c = str[i];
+      if (c == '"' || c == '\\') {
+        this->raw('\\');
+        this->raw(c);
+      } else if (static_cast<uint8_t>(c) < 0x20) {
+        static const char HEX_CHARS[] = "0123456789abcdef";
+        char esc[6] = {'\\', 'u', '0', '0', HEX_CHARS[(c >> 4) & 0x0F], HEX_CHARS[c & 0x0F]};
+        this->raw(esc, sizeof(esc));
+      } else {
+        this->raw(c);
+      }
+    }
+    this->raw('"');
+  }
+
+  // ,"key": (comma left out for the first key of an object)
+  void key(const char *key, bool first = false) {
+    if (!first)
+      this->raw(',');
+    this->raw('"');
+    this->raw(key);
+    this->raw("\":", 2);
+  }
+};
+
+}  // namespace json_state
+
+/** Encode s into buf with the keys, order and conditions of LightJSONSchema::dump_json(), as ArduinoJson would.
+ *
+ * @return Length written (buf is null terminated), or 0 if it didn't fit.
+ */
+inline size_t encode_json_state(const JsonState &s, char *buf, size_t size) {
+  json_state::Writer out{buf, size};
+  bool first = true;
+
+  out.raw('{');
+  if (s.has(JsonState::HAS_EFFECTS)) {
+    out.key("effect", true);
+    out.string(s.effect, s.effect_len);
+    out.key("effect_index");
+    out.uint(s.effect_index);
+    out.key("effect_count");
+    out.uint(s.effect_count);
+    first = false;
+  }
+  if (s.color_mode != nullptr) {
+    out.key("color_mode", first);
+    out.raw('"');
+    out.progmem(s.color_mode);
+    out.raw('"');
+    first = false;
+  }
+  if (s.has(JsonState::HAS_STATE)) {
+    out.key("state", first);
+    out.raw(s.has(JsonState::STATE_ON) ? "\"ON\"" : "\"OFF\"");
+    first = false;
+  }
+  if (s.has(JsonState::HAS_BRIGHTNESS)) {
+    out.key("brightness", first);
+    out.uint(s.brightness);
+    first = false;
+  }
+
+  out.key("color", first);
+  out.raw('{');
+  out.key("r", true);
+  out.uint(s.red);
+  out.key("g");
+  out.uint(s.green);
+  out.key("b");
+  out.uint(s.blue);
+  const bool has_white = s.has(JsonState::HAS_WHITE);
+  const bool has_cwww = s.has(JsonState::HAS_CWWW);
+  if (has_white) {
+    // dump_json() overwrites "w" in place with warm white when both are present
+    out.key("w");
+    out.uint(has_cwww ? s.warm_white : s.white);
+  }
+  if (has_cwww) {
+    out.key("c");
+    out.uint(s.cold_white);
+    if (!has_white) {
+      out.key("w");
+      out.uint(s.warm_white);
+    }
+  }
+  out.raw('}');
+
+  if (has_white) {
+    out.key("white_value");  // legacy API
+    out.uint(s.white);
+  }
+  out.key("color_temp");
+  out.uint(s.color_temp);
+  out.raw('}');
+
+  if (out.overflow)
+    return 0;
+  buf[out.pos] = '\0';
+  return out.pos;
+}
+
+/** Per-light cache of the JsonState and its text, both redone only when the generation passed in moves on.
+ *
+ * Fill is called as fill(JsonState &) on a cleared state.
+ */
+class JsonStateCache {
+ public:
+  /// Size of the text buffer, allocated on the first text() call.
+  static constexpr size_t TEXT_SIZE = 224;
+
+  template<typename Fill> const JsonState &state(uint32_t generation, Fill &&fill) {
+    if (!this->valid_ || this->generation_ != generation) {
+      this->state_ = JsonState{};
+      fill(this->state_);
+      this->generation_ = generation;
+      this->valid_ = true;
+      this->text_valid_ = false;
+    }
+    return this->state_;
+  }
+
+  /// Text of state(generation, fill), nullptr if it doesn't fit TEXT_SIZE.
+  template<typename Fill> const char *text(uint32_t generation, Fill &&fill, size_t *len) {
+    const JsonState &s = this->state(generation, fill);
+    if (!this->text_valid_) {
+      if (this->text_ == nullptr)
+        this->text_ = std::make_unique<char[]>(TEXT_SIZE);
+      this->text_len_ = encode_json_state(s, this->text_.get(), TEXT_SIZE);
+      this->text_valid_ = true;
+    }
+    if (this->text_len_ == 0)
+      return nullptr;
+    if (len != nullptr)
+      *len = this->text_len_;
+    return this->text_.get();
+  }
+
+ protected:
+  JsonState state_;
+  std::unique_ptr<char[]> text_;
+  uint32_t generation_{0};
+  uint16_t text_len_{0};
+  bool valid_{false};
+  bool text_valid_{false};
+};
+
+}  // namespace esphome::light
@@ -2,6 +2,7 @@
 
 #include "light_call.h"
 #include "light_state.h"
+#include "profile.h"
 #include "esphome/core/log.h"
 #include "esphome/core/optional.h"
 #include "esphome/core/progmem.h"
@@ -74,8 +75,57 @@ static void log_percent(const LogString *param, float value) {
 #endif
 
 void LightCall::perform() {
+  KAUF_PROFILE_SCOPE(PROFILE_CALL_PERFORM);
+#ifdef USE_LIGHT_COALESCE
+  // KAUF: published calls (frontends, automations) are merged into one pending call per light that
+  // LightState performs once per loop().  Flashes and internal unpublished calls go straight through.
+  if (this->parent_->coalesce_calls_ && this->get_publish_() && !this->has_flash_() &&
+      this->parent_->is_in_loop_state()) {
+    this->parent_->coalesce_call_(*this);
+    return;
+  }
+  // a call that goes straight through must not be overtaken by an older pending one
+  this->parent_->flush_coalesced_call();
+#endif
+  this->execute_(this->validate_());
+}
+
+void ConstantLightCall::perform() {
+  LightState *parent = this->parent_;
+
+#ifdef USE_LIGHT_COALESCE
+  // merged calls are validated when flushed, nothing to reuse
+  if (parent->coalesce_calls_ && parent->is_in_loop_state()) {
+    LightCall call(parent);
+    this->build_(call);
+    call.perform();
+    return;
+  }
+#endif
+
+  const ValidationInput input{parent->remote_values, parent->active_effect_index_,
+                              parent->default_transition_length_};
+  bool reused;
+  const Validated &validated = this->memo_.get(
+      input,
+      [this, parent](Validated &out) {
+        LightCall call(parent);
+        this->build_(call);
+        out.target = call.validate_();
+        out.call = call;
+      },
+      reused);
+  if (reused)
+    this->reused_++;
+
+  // copies, listeners run while performing may trigger this same call again
+  LightCall call = validated.call;
+  const LightColorValues target = validated.target;
+  call.execute_(target);
+}
+
+void LightCall::execute_(const LightColorValues &v) {
   const char *name = this->parent_->get_name().c_str();
-  LightColorValues v = this->validate_();
   const bool publish = this->get_publish_();
 
   if (publish) {
@@ -179,6 +229,31 @@ void LightCall::perform() {
   }
 }
 
+#ifdef USE_LIGHT_COALESCE
+void LightCall::merge_(const LightCall &other) {
+  const uint16_t incoming = other.flags_;
+
+  // later values win field by field, bits 0-7 line up with unit_fields_
+  for (uint8_t bit = 0; bit < 8; bit++) {
+    if (incoming & (1u << bit))
+      this->unit_fields_[bit] = other.unit_fields_[bit];
+  }
+  if (incoming & FLAG_HAS_COLOR_TEMPERATURE)
+    this->color_temperature_ = other.color_temperature_;
+  if (incoming & FLAG_HAS_STATE)
+    this->state_ = other.state_;
+  if (incoming & FLAG_HAS_TRANSITION)
+    this->transition_length_ = other.transition_length_;
+  if (incoming & FLAG_HAS_EFFECT)
+    this->effect_ = other.effect_;
+  if (incoming & FLAG_HAS_COLOR_MODE)
+    this->color_mode_ = other.color_mode_;
+
+  // publish is always set on merged calls, save if any of them asked for it
+  this->flags_ |= incoming;
+}
+#endif
+
 void LightCall::log_and_clear_unsupported_(FieldFlags flag, const LogString *feature, bool use_color_mode_log) {
   auto *name = this->parent_->get_name().c_str();
   if (use_color_mode_log) {
@@ -191,7 +266,7 @@ void LightCall::log_and_clear_unsupported_(FieldFlags flag, const LogString *fea
 
 LightColorValues LightCall::validate_() {
   auto *name = this->parent_->get_name().c_str();
-  auto traits = this->parent_->get_traits();
+  const auto &traits = this->parent_->get_traits();
 
   // Color mode check
   if (this->has_color_mode() && !traits.supports_color_mode(this->color_mode_)) {
@@ -296,7 +371,7 @@ LightColorValues LightCall::validate_() {
       log_value_out_of_range(name, value, ValidateFieldNames::get_log_str(bit, 0), 0.0f, 1.0f);
       value = clamp_unit_float(value);
     }
-    v.unit_fields_[bit] = value;
+    v.unit_fields_[bit] = LightColorValues::to_unit_(value);
   }
 
   // color_temperature: runtime range from traits.  KAUF: suppress warning if within 1 mired of valid range.
@@ -309,7 +384,7 @@ LightColorValues LightCall::validate_() {
                                ct_min, ct_max);
       this->color_temperature_ = clamp(this->color_temperature_, ct_min, ct_max);
     }
-    v.color_temperature_ = this->color_temperature_;
+    v.color_temperature_ = LightColorValues::to_mired_(this->color_temperature_);
   }
 
   v.normalize_color();
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "esphome/core/defines.h"
 #include "light_color_values.h"
+#include "validation_memo.h"
 
 namespace esphome {
 
@@ -181,21 +183,8 @@ class LightCall {
 
   void perform();
 
- protected:
-  /// Get the currently targeted, or active if none set, color mode.
-  ColorMode get_active_color_mode_();
-
-  /// Validate all properties and return the target light color values.
-  LightColorValues validate_();
-
-  //// Compute the color mode that should be used for this call.
-  ColorMode compute_color_mode_(const LightTraits &traits);
-  /// Get potential color modes bitmask for this light call.
-  color_mode_bitmask_t get_suitable_color_modes_mask_();
-  /// Some color modes also can be set using non-native parameters, transform those calls.
-  void transform_parameters_(const LightTraits &traits);
-
   // Bits 0-7 index unit_fields_[] in validate_(); don't reorder (asserts in light_call.cpp).
+  // KAUF: public so compact control protocols can mirror the bitmask on the wire.
   enum FieldFlags : uint16_t {
     FLAG_HAS_BRIGHTNESS = 1 << 0,
     FLAG_HAS_COLOR_BRIGHTNESS = 1 << 1,
@@ -214,6 +203,31 @@ class LightCall {
     FLAG_PUBLISH = 1 << 14,
     FLAG_SAVE = 1 << 15,
   };
+
+ protected:
+  /// Get the currently targeted, or active if none set, color mode.
+  ColorMode get_active_color_mode_();
+
+  friend LightState;
+  friend class ConstantLightCall;
+  friend class LightEffect;
+
+  /// Validate all properties and return the target light color values.
+  LightColorValues validate_();
+  /// Apply already validated target values: start flash/transition/effect or set immediately, publish and save.
+  void execute_(const LightColorValues &v);
+#ifdef USE_LIGHT_COALESCE
+  /// KAUF: merge the set fields of another (later) call into this one.
+  void merge_(const LightCall &other);
+#endif
+
+  //// Compute the color mode that should be used for this call.
+  ColorMode compute_color_mode_(const LightTraits &traits);
+  /// Get potential color modes bitmask for this light call.
+  color_mode_bitmask_t get_suitable_color_modes_mask_();
+  /// Some color modes also can be set using non-native parameters, transform those calls.
+  void transform_parameters_(const LightTraits &traits);
+
   static constexpr uint16_t CLAMP_FLAGS_MASK = 0x00FFu;  // bits 0-7
 
   inline bool has_transition_() { return (this->flags_ & FLAG_HAS_TRANSITION) != 0; }
@@ -243,7 +257,7 @@ class LightCall {
   uint32_t transition_length_;
   uint32_t flash_length_;
   uint32_t effect_;
-  ESPHOME_LIGHT_UNIT_FIELDS_UNION();
+  ESPHOME_LIGHT_UNIT_FIELDS_UNION(float);
   float color_temperature_;
 
   // Smaller members at the end for better packing
@@ -252,5 +266,35 @@ class LightCall {
   bool state_;
 };
 
+/** KAUF: a call whose fields are all compile-time constants, e.g. most light.turn_on actions.
+ *
+ * Validating such a call only depends on the light's remote_values, active effect and default transition, so the validated call
+ * and its target values are kept and performed again as long as those still match the last validation.
+ * Anything else builds and validates the call like a regular perform().
+ */
+class ConstantLightCall {
+ public:
+  using BuildFn = void (*)(LightCall &);
+  ConstantLightCall(LightState *parent, BuildFn build) : parent_(parent), memo_(parent), build_(build) {}
+
+  void perform();
+
+  /// Number of performs that reused the last validation.
+  uint32_t get_reuse_count() const { return this->reused_; }
+
+ protected:
+  /// The validated call and its target values.
+  struct Validated {
+    explicit Validated(LightState *parent) : call(parent) {}
+    LightCall call;
+    LightColorValues target;
+  };
+
+  LightState *parent_;
+  ValidationMemo<Validated> memo_;
+  uint32_t reused_{0};
+  BuildFn build_;
+};
+
 }  // namespace light
 }  // namespace esphome
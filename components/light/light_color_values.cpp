@@ -2,6 +2,23 @@
 
 namespace esphome::light {
 
+#ifdef USE_LIGHT_COMPACT_VALUES
+// KAUF: integer lerp, completion as Q15 so (b - a) * t fits in int32.
+static inline uint16_t lerp_unit(uint16_t a, uint16_t b, int32_t t) {
+  return static_cast<uint16_t>(a + (((int32_t(b) - int32_t(a)) * t) >> 15));
+}
+
+LightColorValues LightColorValues::lerp(const LightColorValues &start, const LightColorValues &end, float completion) {
+  const int32_t t = static_cast<int32_t>(clamp_unit_float(completion) * 32768.0f + 0.5f);
+  LightColorValues v;
+  v.color_mode_ = end.color_mode_;
+  v.state_ = lerp_unit(start.state_, end.state_, t);
+  for (uint8_t i = 0; i < 8; i++)
+    v.unit_fields_[i] = lerp_unit(start.unit_fields_[i], end.unit_fields_[i], t);
+  v.color_temperature_ = lerp_unit(start.color_temperature_, end.color_temperature_, t);
+  return v;
+}
+#else
 // Lightweight lerp: a + t * (b - a).
 // Avoids std::lerp's NaN/infinity handling which Clang doesn't optimize out,
 // adding ~200 bytes per call. Safe because all values are finite floats.
@@ -27,5 +44,6 @@ LightColorValues LightColorValues::lerp(const LightColorValues &start, const Lig
   v.warm_white_ = lerp_fast(start.warm_white_, end.warm_white_, completion);
   return v;
 }
+#endif
 
 }  // namespace esphome::light
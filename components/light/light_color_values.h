@@ -1,5 +1,6 @@
 #pragma once
 
+#include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
 #include "color_mode.h"
 #include <cmath>
@@ -42,23 +43,37 @@ inline float clamp_unit_float(float x) {
   return (pun.u & NEG_ZERO_F_BITS) ? 0.0f : 1.0f;  // sign bit → negative → clamp to 0
 }
 
-// Shared anonymous union: eight unit-range floats alias unit_fields_[8] so
+// Shared anonymous union: eight unit-range values alias unit_fields_[8] so
 // LightCall::validate_() can iterate them as a real array. GCC/Clang ext.
-#define ESPHOME_LIGHT_UNIT_FIELDS_UNION() \
+// KAUF: element type is a parameter, LightColorValues may store them compact.
+#define ESPHOME_LIGHT_UNIT_FIELDS_UNION(type) \
   union { \
     struct { \
-      float brightness_; \
-      float color_brightness_; \
-      float red_; \
-      float green_; \
-      float blue_; \
-      float white_; \
-      float cold_white_; \
-      float warm_white_; \
+      type brightness_; \
+      type color_brightness_; \
+      type red_; \
+      type green_; \
+      type blue_; \
+      type white_; \
+      type cold_white_; \
+      type warm_white_; \
     }; \
-    float unit_fields_[8]; \
+    type unit_fields_[8]; \
   }
 
+#ifdef USE_LIGHT_COMPACT_VALUES
+/// KAUF: unit-range values stored as uint16 0-65535, color temperature as uint16 in 1/32 mireds.  Build-wide, set with
+/// compact_color_values in a top level kauf_rgbww: block.
+using light_unit_t = uint16_t;
+using light_mired_t = uint16_t;
+static constexpr light_unit_t LIGHT_UNIT_ONE = 65535;
+static constexpr float LIGHT_MIRED_SCALE = 32.0f;
+#else
+using light_unit_t = float;
+using light_mired_t = float;
+static constexpr light_unit_t LIGHT_UNIT_ONE = 1.0f;
+#endif
+
 /** This class represents the color state for a light object.
  *
  * The representation of the color state is dependent on the active color mode. A color mode consists of multiple
@@ -96,16 +111,16 @@ class LightColorValues {
  public:
   /// Construct the LightColorValues with all attributes enabled, but state set to off.
   LightColorValues()
-      : state_(0.0f),
-        brightness_(1.0f),
-        color_brightness_(1.0f),
-        red_(1.0f),
-        green_(1.0f),
-        blue_(1.0f),
-        white_(1.0f),
-        cold_white_{1.0f},
-        warm_white_{1.0f},
-        color_temperature_{0.0f},
+      : state_(0),
+        brightness_(LIGHT_UNIT_ONE),
+        color_brightness_(LIGHT_UNIT_ONE),
+        red_(LIGHT_UNIT_ONE),
+        green_(LIGHT_UNIT_ONE),
+        blue_(LIGHT_UNIT_ONE),
+        white_(LIGHT_UNIT_ONE),
+        cold_white_{LIGHT_UNIT_ONE},
+        warm_white_{LIGHT_UNIT_ONE},
+        color_temperature_{0},
         color_mode_(ColorMode::UNKNOWN) {}
 
   LightColorValues(ColorMode color_mode, float state, float brightness, float color_brightness, float red, float green,
@@ -150,6 +165,18 @@ class LightColorValues {
    * @param traits Used for determining which attributes to consider.
    */
   void normalize_color() {
+#ifdef USE_LIGHT_COMPACT_VALUES
+    if (this->color_mode_ & ColorCapability::RGB) {
+      const uint32_t max_value = std::max(this->red_, std::max(this->green_, this->blue_));
+      if (max_value == 0) {
+        this->red_ = this->green_ = this->blue_ = LIGHT_UNIT_ONE;
+      } else if (max_value != LIGHT_UNIT_ONE) {
+        this->red_ = (this->red_ * uint32_t(LIGHT_UNIT_ONE) + max_value / 2) / max_value;
+        this->green_ = (this->green_ * uint32_t(LIGHT_UNIT_ONE) + max_value / 2) / max_value;
+        this->blue_ = (this->blue_ * uint32_t(LIGHT_UNIT_ONE) + max_value / 2) / max_value;
+      }
+    }
+#else
     if (this->color_mode_ & ColorCapability::RGB) {
       float max_value = fmaxf(this->red_, fmaxf(this->green_, this->blue_));
       // Assign directly to avoid redundant clamp in set_red/green/blue.
@@ -166,28 +193,29 @@ class LightColorValues {
         this->blue_ *= inv;
       }
     }
+#endif
   }
 
   /// Convert these light color values to a binary representation and write them to binary.
-  void as_binary(bool *binary) const { *binary = this->state_ == 1.0f; }
+  void as_binary(bool *binary) const { *binary = this->state_ == LIGHT_UNIT_ONE; }
 
   /// Convert these light color values to a brightness-only representation and write them to brightness.
-  void as_brightness(float *brightness) const { *brightness = this->state_ * this->brightness_; }
+  void as_brightness(float *brightness) const { *brightness = from_unit_(mul_unit_(this->state_, this->brightness_)); }
 
   /// Convert these light color values to an RGB representation and write them to red, green, blue.
   void as_rgb(float *red, float *green, float *blue) const {
     // KAUF: always return RGB values.
-    float brightness = this->state_ * this->brightness_ * this->color_brightness_;
-    *red = brightness * this->red_;
-    *green = brightness * this->green_;
-    *blue = brightness * this->blue_;
+    const light_unit_t brightness = mul_unit_(mul_unit_(this->state_, this->brightness_), this->color_brightness_);
+    *red = from_unit_(mul_unit_(brightness, this->red_));
+    *green = from_unit_(mul_unit_(brightness, this->green_));
+    *blue = from_unit_(mul_unit_(brightness, this->blue_));
   }
 
   /// Convert these light color values to an RGBW representation and write them to red, green, blue, white.
   void as_rgbw(float *red, float *green, float *blue, float *white) const {
     this->as_rgb(red, green, blue);
     if (this->color_mode_ & ColorCapability::WHITE) {
-      *white = this->state_ * this->brightness_ * this->white_;
+      *white = this->get_white_brightness();
     } else {
       *white = 0;
     }
@@ -220,9 +248,9 @@ class LightColorValues {
   /// implementation.
   void as_cwww(float *cold_white, float *warm_white, bool constant_brightness = false) const {
     if (this->color_mode_ & ColorCapability::COLD_WARM_WHITE) {
-      const float cw_level = this->cold_white_;
-      const float ww_level = this->warm_white_;
-      const float white_level = this->state_ * this->brightness_;
+      const float cw_level = from_unit_(this->cold_white_);
+      const float ww_level = from_unit_(this->warm_white_);
+      const float white_level = from_unit_(mul_unit_(this->state_, this->brightness_));
       if (!constant_brightness) {
         *cold_white = white_level * cw_level;
         *warm_white = white_level * ww_level;
@@ -245,10 +273,9 @@ class LightColorValues {
   void as_ct(float color_temperature_cw, float color_temperature_ww, float *color_temperature,
              float *white_brightness) const {
     // KAUF: Always return values
-    const float white_level = this->white_;
     *color_temperature =
-        (this->color_temperature_ - color_temperature_cw) / (color_temperature_ww - color_temperature_cw);
-    *white_brightness = this->state_ * this->brightness_ * white_level;
+        (this->get_color_temperature() - color_temperature_cw) / (color_temperature_ww - color_temperature_cw);
+    *white_brightness = this->get_white_brightness();
   }
 
   /// Compare this LightColorValues to rhs, return true if and only if all attributes match.
@@ -266,84 +293,111 @@ class LightColorValues {
   void set_color_mode(ColorMode color_mode) { this->color_mode_ = color_mode; }
 
   /// Get the state of these light color values. In range from 0.0 (off) to 1.0 (on)
-  float get_state() const { return this->state_; }
+  float get_state() const { return from_unit_(this->state_); }
   /// Get the binary true/false state of these light color values.
-  bool is_on() const { return this->get_state() != 0.0f; }
+  bool is_on() const { return this->state_ != 0; }
   /// Set the state of these light color values. In range from 0.0 (off) to 1.0 (on)
-  void set_state(float state) { this->state_ = clamp_unit_float(state); }
+  void set_state(float state) { this->state_ = to_unit_(state); }
   /// Set the state of these light color values as a binary true/false.
-  void set_state(bool state) { this->state_ = state ? 1.0f : 0.0f; }
+  void set_state(bool state) { this->state_ = state ? LIGHT_UNIT_ONE : 0; }
 
   /// Get the brightness property of these light color values. In range 0.0 to 1.0
-  float get_brightness() const { return this->brightness_; }
+  float get_brightness() const { return from_unit_(this->brightness_); }
   /// Set the brightness property of these light color values. In range 0.0 to 1.0
-  void set_brightness(float brightness) { this->brightness_ = clamp_unit_float(brightness); }
+  void set_brightness(float brightness) { this->brightness_ = to_unit_(brightness); }
 
   /// KAUF: Get CT white brightness term used by as_ct(): state * brightness * white.
-  float get_white_brightness() const { return this->state_ * this->brightness_ * this->white_; }
+  float get_white_brightness() const {
+    return from_unit_(mul_unit_(mul_unit_(this->state_, this->brightness_), this->white_));
+  }
 
   /// Get the color brightness property of these light color values. In range 0.0 to 1.0
-  float get_color_brightness() const { return this->color_brightness_; }
+  float get_color_brightness() const { return from_unit_(this->color_brightness_); }
   /// Set the color brightness property of these light color values. In range 0.0 to 1.0
-  void set_color_brightness(float brightness) { this->color_brightness_ = clamp_unit_float(brightness); }
+  void set_color_brightness(float brightness) { this->color_brightness_ = to_unit_(brightness); }
 
   /// Get the red property of these light color values. In range 0.0 to 1.0
-  float get_red() const { return this->red_; }
+  float get_red() const { return from_unit_(this->red_); }
   /// Set the red property of these light color values. In range 0.0 to 1.0
-  void set_red(float red) { this->red_ = clamp_unit_float(red); }
+  void set_red(float red) { this->red_ = to_unit_(red); }
 
   /// Get the green property of these light color values. In range 0.0 to 1.0
-  float get_green() const { return this->green_; }
+  float get_green() const { return from_unit_(this->green_); }
   /// Set the green property of these light color values. In range 0.0 to 1.0
-  void set_green(float green) { this->green_ = clamp_unit_float(green); }
+  void set_green(float green) { this->green_ = to_unit_(green); }
 
   /// Get the blue property of these light color values. In range 0.0 to 1.0
-  float get_blue() const { return this->blue_; }
+  float get_blue() const { return from_unit_(this->blue_); }
   /// Set the blue property of these light color values. In range 0.0 to 1.0
-  void set_blue(float blue) { this->blue_ = clamp_unit_float(blue); }
+  void set_blue(float blue) { this->blue_ = to_unit_(blue); }
 
   /// Get the white property of these light color values. In range 0.0 to 1.0
-  float get_white() const { return white_; }
+  float get_white() const { return from_unit_(this->white_); }
   /// Set the white property of these light color values. In range 0.0 to 1.0
-  void set_white(float white) { this->white_ = clamp_unit_float(white); }
+  void set_white(float white) { this->white_ = to_unit_(white); }
 
   /// Get the color temperature property of these light color values in mired.
-  float get_color_temperature() const { return this->color_temperature_; }
+  float get_color_temperature() const { return from_mired_(this->color_temperature_); }
   /// Set the color temperature property of these light color values in mired.
-  void set_color_temperature(float color_temperature) { this->color_temperature_ = color_temperature; }
+  void set_color_temperature(float color_temperature) { this->color_temperature_ = to_mired_(color_temperature); }
 
   /// Get the color temperature property of these light color values in kelvin.
   float get_color_temperature_kelvin() const {
-    if (this->color_temperature_ <= 0) {
-      return this->color_temperature_;
+    const float color_temperature = this->get_color_temperature();
+    if (color_temperature <= 0) {
+      return color_temperature;
     }
-    return 1000000.0f / this->color_temperature_;
+    return 1000000.0f / color_temperature;
   }
   /// Set the color temperature property of these light color values in kelvin.
   void set_color_temperature_kelvin(float color_temperature) {
     if (color_temperature <= 0) {
       return;
     }
-    this->color_temperature_ = 1000000.0f / color_temperature;
+    this->set_color_temperature(1000000.0f / color_temperature);
   }
 
   /// Get the cold white property of these light color values. In range 0.0 to 1.0.
-  float get_cold_white() const { return this->cold_white_; }
+  float get_cold_white() const { return from_unit_(this->cold_white_); }
   /// Set the cold white property of these light color values. In range 0.0 to 1.0.
-  void set_cold_white(float cold_white) { this->cold_white_ = clamp_unit_float(cold_white); }
+  void set_cold_white(float cold_white) { this->cold_white_ = to_unit_(cold_white); }
 
   /// Get the warm white property of these light color values. In range 0.0 to 1.0.
-  float get_warm_white() const { return this->warm_white_; }
+  float get_warm_white() const { return from_unit_(this->warm_white_); }
   /// Set the warm white property of these light color values. In range 0.0 to 1.0.
-  void set_warm_white(float warm_white) { this->warm_white_ = clamp_unit_float(warm_white); }
+  void set_warm_white(float warm_white) { this->warm_white_ = to_unit_(warm_white); }
 
   friend class LightCall;
   friend class LightTransitionTransformer; // KAUF
 
  protected:
-  float state_;  ///< ON / OFF, float for transition
-  ESPHOME_LIGHT_UNIT_FIELDS_UNION();
-  float color_temperature_;  ///< Color Temperature in Mired
+  // KAUF: conversions between the float API and storage, and storage-space multiply.
+#ifdef USE_LIGHT_COMPACT_VALUES
+  static light_unit_t to_unit_(float x) { return static_cast<light_unit_t>(clamp_unit_float(x) * 65535.0f + 0.5f); }
+  static float from_unit_(light_unit_t x) { return x * (1.0f / 65535.0f); }
+  // a * b / 65535, rounded down
+  static light_unit_t mul_unit_(uint32_t a, uint32_t b) {
+    const uint32_t x = a * b;
+    return static_cast<light_unit_t>((x + (x >> 16) + 1) >> 16);
+  }
+  static light_mired_t to_mired_(float mireds) {
+    if (mireds <= 0.0f)
+      return 0;
+    const float scaled = mireds * LIGHT_MIRED_SCALE + 0.5f;
+    return scaled >= 65535.0f ? 65535 : static_cast<light_mired_t>(scaled);
+  }
+  static float from_mired_(light_mired_t x) { return x * (1.0f / LIGHT_MIRED_SCALE); }
+#else
+  static light_unit_t to_unit_(float x) { return clamp_unit_float(x); }
+  static float from_unit_(light_unit_t x) { return x; }
+  static light_unit_t mul_unit_(light_unit_t a, light_unit_t b) { return a * b; }
+  static light_mired_t to_mired_(float mireds) { return mireds; }
+  static float from_mired_(light_mired_t x) { return x; }
+#endif
+
+  light_unit_t state_;  ///< ON / OFF, float for transition
+  ESPHOME_LIGHT_UNIT_FIELDS_UNION(light_unit_t);
+  light_mired_t color_temperature_;  ///< Color Temperature in Mired
   ColorMode color_mode_;
 };
 
@@ -1,5 +1,11 @@
 #include "light_effect.h"
 #include "light_state.h"
+#include "esphome/core/helpers.h"
+
+#ifdef USE_LIGHT_EFFECT_SYNC
+#include "effect_sync.h"
+#include <sys/time.h>
+#endif
 
 namespace esphome::light {
 
@@ -31,4 +37,37 @@ uint32_t LightEffect::get_index_in_parent_() const {
   return 0;  // Not found
 }
 
+void LightEffect::write_values_(const LightColorValues &values, bool transition) {
+  this->state_->write_effect_values_(values, transition);
+}
+
+LightColorValues LightEffect::validate_call_(LightCall &call) { return call.validate_(); }
+
+#ifdef USE_LIGHT_EFFECT_SYNC
+// any time: platform sets the system clock, anything before 2020 means it hasn't synced yet
+static const time_t SYNC_MIN_EPOCH = 1577836800;
+#endif
+
+bool LightEffect::sync_period_(uint32_t interval, uint32_t &period, uint32_t &offset) const {
+#ifdef USE_LIGHT_EFFECT_SYNC
+  if (!this->clock_sync_ || interval == 0)
+    return false;
+  struct timeval tv;
+  if (gettimeofday(&tv, nullptr) != 0 || tv.tv_sec < SYNC_MIN_EPOCH)
+    return false;
+  effect_sync_period(uint64_t(tv.tv_sec) * 1000 + tv.tv_usec / 1000, interval, period, offset);
+  return true;
+#else
+  return false;
+#endif
+}
+
+float LightEffect::effect_random_(bool synced, uint32_t period, uint8_t n) const {
+#ifdef USE_LIGHT_EFFECT_SYNC
+  if (synced)
+    return effect_sync_random(this->seed_, period, n);
+#endif
+  return random_float();
+}
+
 }  // namespace esphome::light
@@ -1,11 +1,15 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 #include "esphome/core/string_ref.h"
+#include "profile.h"
 
 namespace esphome::light {
 
 class LightState;
+class LightCall;
+class LightColorValues;
 
 class LightEffect {
  public:
@@ -22,6 +26,26 @@ class LightEffect {
   /// Apply this effect. Use the provided state for starting transitions, ...
   virtual void apply() = 0;
 
+  /// KAUF: called by LightState on every loop, runs apply() once the effect's frame interval is up.
+  void apply_frame(uint32_t now) {
+    if (now - this->last_frame_ < this->frame_interval_)
+      return;
+    this->last_frame_ = now;
+    KAUF_PROFILE_CALL(PROFILE_EFFECT_APPLY, this->apply());
+  }
+
+  /// KAUF: minimum ms between apply() calls, 0 to apply on every loop.
+  void set_frame_interval(uint32_t frame_interval) { this->frame_interval_ = frame_interval; }
+
+#ifdef USE_LIGHT_EFFECT_SYNC
+  /// KAUF: take phase from the wall clock and random values from seed, so bulbs with the same config render the
+  /// same frames without talking to each other. Effects fall back to millis() until the clock is set.
+  void set_clock_sync(uint32_t seed) {
+    this->clock_sync_ = true;
+    this->seed_ = seed;
+  }
+#endif
+
   /**
    * Returns the name of this effect.
    * The underlying data is valid for the lifetime of the program (static string from codegen).
@@ -53,6 +77,31 @@ class LightEffect {
 
   /// Internal method to find this effect's index in the parent light's effect list.
   uint32_t get_index_in_parent_() const;
+
+  /** KAUF: direct-write path.  Put values straight into current_values for the next write_state(), replacing any
+   * transition.  No validation, publish or save, so values must already be valid for the light, e.g. from
+   * validate_call_() or remote_values.  Set transition for values in the Tasmota gamma space of
+   * LightTransitionTransformer (LightEffectFade), the output then renders them like a transition.
+   */
+  void write_values_(const LightColorValues &values, bool transition = false);
+
+  /// KAUF: validate call against the light's current target and return its values, without performing it.
+  LightColorValues validate_call_(LightCall &call);
+
+  /// KAUF: with clock sync and the clock set, index of the current interval-long period of the wall clock and ms
+  /// into it. Returns false otherwise, the effect then keeps its own millis() phase.
+  bool sync_period_(uint32_t interval, uint32_t &period, uint32_t &offset) const;
+
+  /// KAUF: random value in [0, 1), from seed, period and draw n when synced so every bulb gets the same.
+  float effect_random_(bool synced, uint32_t period, uint8_t n) const;
+
+#ifdef USE_LIGHT_EFFECT_SYNC
+  bool clock_sync_{false};
+  uint32_t seed_{0};
+#endif
+
+  uint32_t frame_interval_{0};
+  uint32_t last_frame_{0};
 };
 
 }  // namespace esphome::light
@@ -1,6 +1,9 @@
 #include "light_json_schema.h"
 #include "color_mode.h"
+#include "json_command.h"
+#include "json_state.h"
 #include "light_output.h"
+#include "profile.h"
 #include "esphome/core/progmem.h"
 
 #ifdef USE_JSON
@@ -24,48 +27,102 @@ static ProgmemStr get_color_mode_json_str(ColorMode mode) {
   return ColorModeStrings::get_progmem_str(bit - 1, ColorModeStrings::LAST_INDEX);
 }
 
-void LightJSONSchema::dump_json(LightState &state, JsonObject root) {
-  // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks) false positive with ArduinoJson
+// KAUF: the values dump_json() and the text cache report, worked out once per remote values generation.
+static void fill_json_state(LightState &state, JsonState &s) {
   if (state.supports_effects()) {
-    root[ESPHOME_F("effect")] = state.get_effect_name().c_str();
-    root[ESPHOME_F("effect_index")] = state.get_current_effect_index();
-    root[ESPHOME_F("effect_count")] = state.get_effect_count();
+    auto effect = state.get_effect_name();
+    s.flags |= JsonState::HAS_EFFECTS;
+    s.effect = effect.c_str();
+    s.effect_len = effect.size();
+    s.effect_index = state.get_current_effect_index();
+    s.effect_count = state.get_effect_count();
   }
 
-  auto values = state.remote_values;
-
+  const auto &values = state.remote_values;
   const auto color_mode = values.get_color_mode();
-  const auto *mode_str = get_color_mode_json_str(color_mode);
-  if (mode_str != nullptr) {
-    root[ESPHOME_F("color_mode")] = mode_str;
-  }
+  s.color_mode = reinterpret_cast<const char *>(get_color_mode_json_str(color_mode));
 
-  if (color_mode & ColorCapability::ON_OFF)
-    root[ESPHOME_F("state")] = (values.get_state() != 0.0f) ? "ON" : "OFF";
-  if (color_mode & ColorCapability::BRIGHTNESS)
-    root[ESPHOME_F("brightness")] = to_uint8_scale(values.get_brightness());
+  if (color_mode & ColorCapability::ON_OFF) {
+    s.flags |= JsonState::HAS_STATE;
+    if (values.get_state() != 0.0f)
+      s.flags |= JsonState::STATE_ON;
+  }
+  if (color_mode & ColorCapability::BRIGHTNESS) {
+    s.flags |= JsonState::HAS_BRIGHTNESS;
+    s.brightness = to_uint8_scale(values.get_brightness());
+  }
 
-  JsonObject color = root[ESPHOME_F("color")].to<JsonObject>();
   // KAUF: Always report RGB so clients can restore from CT mode.
   float color_brightness = values.get_color_brightness();
-  color[ESPHOME_F("r")] = to_uint8_scale(color_brightness * values.get_red());
-  color[ESPHOME_F("g")] = to_uint8_scale(color_brightness * values.get_green());
-  color[ESPHOME_F("b")] = to_uint8_scale(color_brightness * values.get_blue());
+  s.red = to_uint8_scale(color_brightness * values.get_red());
+  s.green = to_uint8_scale(color_brightness * values.get_green());
+  s.blue = to_uint8_scale(color_brightness * values.get_blue());
 
   if (color_mode & ColorCapability::WHITE) {
-    uint8_t white_val = to_uint8_scale(values.get_white());
-    color[ESPHOME_F("w")] = white_val;
-    root[ESPHOME_F("white_value")] = white_val;  // legacy API
+    s.flags |= JsonState::HAS_WHITE;
+    s.white = to_uint8_scale(values.get_white());
   }
   // KAUF: Always report CT so clients can restore from RGB mode.
-  // this one isn't under the color subkey for some reason
-  root[ESPHOME_F("color_temp")] = uint32_t(values.get_color_temperature());
+  s.color_temp = uint32_t(values.get_color_temperature());
   if (color_mode & ColorCapability::COLD_WARM_WHITE) {
-    color[ESPHOME_F("c")] = to_uint8_scale(values.get_cold_white());
-    color[ESPHOME_F("w")] = to_uint8_scale(values.get_warm_white());
+    s.flags |= JsonState::HAS_CWWW;
+    s.cold_white = to_uint8_scale(values.get_cold_white());
+    s.warm_white = to_uint8_scale(values.get_warm_white());
   }
 }
 
+const JsonState &LightJSONSchema::json_state_(LightState &state) {
+  return state.json_cache_.state(state.get_remote_values_generation(),
+                                 [&state](JsonState &s) { fill_json_state(state, s); });
+}
+
+void LightJSONSchema::dump_json(LightState &state, JsonObject root) {
+  KAUF_PROFILE_SCOPE(PROFILE_DUMP_JSON);
+  const JsonState &s = json_state_(state);
+
+  // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks) false positive with ArduinoJson
+  if (s.has(JsonState::HAS_EFFECTS)) {
+    root[ESPHOME_F("effect")] = s.effect;
+    root[ESPHOME_F("effect_index")] = s.effect_index;
+    root[ESPHOME_F("effect_count")] = s.effect_count;
+  }
+
+  if (s.color_mode != nullptr) {
+    root[ESPHOME_F("color_mode")] = reinterpret_cast<ProgmemStr>(s.color_mode);
+  }
+
+  if (s.has(JsonState::HAS_STATE))
+    root[ESPHOME_F("state")] = s.has(JsonState::STATE_ON) ? "ON" : "OFF";
+  if (s.has(JsonState::HAS_BRIGHTNESS))
+    root[ESPHOME_F("brightness")] = s.brightness;
+
+  JsonObject color = root[ESPHOME_F("color")].to<JsonObject>();
+  color[ESPHOME_F("r")] = s.red;
+  color[ESPHOME_F("g")] = s.green;
+  color[ESPHOME_F("b")] = s.blue;
+
+  if (s.has(JsonState::HAS_WHITE)) {
+    color[ESPHOME_F("w")] = s.white;
+    root[ESPHOME_F("white_value")] = s.white;  // legacy API
+  }
+  // this one isn't under the color subkey for some reason
+  root[ESPHOME_F("color_temp")] = s.color_temp;
+  if (s.has(JsonState::HAS_CWWW)) {
+    color[ESPHOME_F("c")] = s.cold_white;
+    color[ESPHOME_F("w")] = s.warm_white;
+  }
+}
+
+size_t LightJSONSchema::encode_json(LightState &state, char *buf, size_t size) {
+  KAUF_PROFILE_SCOPE(PROFILE_DUMP_JSON);
+  return encode_json_state(json_state_(state), buf, size);
+}
+
+const char *LightJSONSchema::get_cached_json(LightState &state, size_t *len) {
+  return state.json_cache_.text(state.get_remote_values_generation(),
+                                [&state](JsonState &s) { fill_json_state(state, s); }, len);
+}
+
 void LightJSONSchema::parse_color_json(LightState &state, LightCall &call, JsonObject root) {
   if (root[ESPHOME_F("state")].is<const char *>()) {
     auto val = parse_on_off(root[ESPHOME_F("state")]);
@@ -159,6 +216,21 @@ void LightJSONSchema::parse_json(LightState &state, LightCall &call, JsonObject
   }
 }
 
+bool LightJSONSchema::parse_json(LightState &state, LightCall &call, const char *data, size_t len) {
+  JsonCommand cmd;
+  if (parse_json_command(data, len, cmd)) {
+    apply_json_command(cmd, call, state.remote_values.is_on());
+    return true;
+  }
+
+  JsonDocument doc = json::parse_json(reinterpret_cast<const uint8_t *>(data), len);
+  JsonObject root = doc.as<JsonObject>();
+  if (root.isNull())
+    return false;
+  LightJSONSchema::parse_json(state, call, root);
+  return true;
+}
+
 }  // namespace esphome::light
 
 #endif
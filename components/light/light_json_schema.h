@@ -12,12 +12,37 @@ namespace esphome::light {
 
 class LightJSONSchema {
  public:
-  /// Dump the state of a light as JSON.
+  /** Dump the state of a light as JSON.
+   *
+   * KAUF: the values come from the light's JsonStateCache (json_state.h), worked out once per remote values change
+   * and shared by every caller (web_server SSE and REST, MQTT state).  Only the insertion into root is per caller.
+   */
   static void dump_json(LightState &state, JsonObject root);
+  /** KAUF: Encode the same JSON as dump_json() straight into buf, without a JsonDocument.
+   *
+   * @return Length written (buf is null terminated), or 0 if it didn't fit.
+   */
+  static size_t encode_json(LightState &state, char *buf, size_t size);
+  /** KAUF: JSON text of the light's state, shared between all readers.
+   *
+   * Only re-encoded when the light's remote values generation changes, so every reader shares one
+   * serialization per change (kauf_udp_control state queries). Returns nullptr if the state doesn't fit
+   * JsonStateCache::TEXT_SIZE (long effect names), callers should fall back to dump_json() then.
+   */
+  static const char *get_cached_json(LightState &state, size_t *len = nullptr);
   /// Parse the JSON state of a light to a LightCall.
   static void parse_json(LightState &state, LightCall &call, JsonObject root);
+  /** KAUF: Parse a JSON command from its text to a LightCall.
+   *
+   * Tries the single pass reader in json_command.h first, which takes the plain commands Home Assistant sends, and
+   * hands anything else to ArduinoJson and the JsonObject overload.  Returns false if the text isn't a JSON object.
+   */
+  static bool parse_json(LightState &state, LightCall &call, const char *data, size_t len);
 
  protected:
+  /// KAUF: the light's JsonState for its current remote values generation.
+  static const JsonState &json_state_(LightState &state);
+
   static void parse_color_json(LightState &state, LightCall &call, JsonObject root);
 };
 
@@ -29,6 +29,33 @@ class LightOutput {
   /// preceded by (at least) one call to update_state().
   virtual void write_state(LightState *state) = 0;
 
+#ifdef USE_LIGHT_SCENES
+  /// KAUF: copy the hardware levels of the last write_state() into levels (LIGHT_SCENE_LEVELS floats) so a
+  /// scene slot can skip the mixing on recall.  Only asked while current_values are settled on remote_values.
+  /// Return false if the output can't replay its levels.
+  virtual bool capture_levels(LightState *state, float *levels) { return false; }
+
+  /// KAUF: write levels from capture_levels() straight to hardware in place of write_state(), current_values
+  /// already hold the matching values.  Return false to have write_state() run as usual.
+  virtual bool apply_levels(LightState *state, const float *levels) { return false; }
+#endif
+
+#ifdef KAUF_TIMED_TRANSITIONS
+  /// KAUF: render a transition from a timer at a fixed cadence instead of from write_state() every loop, by sampling
+  /// the transformer (LightTransformer::sample()) ahead.  Runs until stop_timed_transition().  Return false to have
+  /// loop() render it as usual.
+  virtual bool start_timed_transition(LightState *state, LightTransformer *transformer, uint32_t length) { return false; }
+
+  /// KAUF: stop the timed transition, the transformer is done or replaced.  The next write_state() takes over.
+  virtual void stop_timed_transition() {}
+#endif
+
+#ifdef KAUF_OUTPUT_HANDOFF
+  /// KAUF: true if setup_state() put the hardware back on its levels from before a warm reset.  LightState::setup()
+  /// then leaves them up instead of writing the restored values, the next change writes as usual.
+  virtual bool has_handoff_levels() { return false; }
+#endif
+
   bool is_aux( ) {return aux;}
   void set_aux(bool aux_in) { aux = aux_in; }
 
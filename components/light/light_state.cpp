@@ -1,28 +1,105 @@
+#include <cinttypes>
+#include <cmath>
+
 #include "light_state.h"
 #include "esp_color_correction.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/controller_registry.h"
 #include "esphome/core/log.h"
 #include "light_output.h"
+#include "profile.h"
 #include "transformers.h"
 #ifdef USE_ESP8266
 #include "esphome/components/esp8266/preferences.h"  // KAUF: forced_addr support
 #endif
+#ifdef KAUF_SINGLE_OUTPUT
+#include "esphome/components/kauf_rgbww/kauf_rgbww.h"  // KAUF: the one output type
+#endif
 
 namespace esphome::light {
 
+// KAUF: every call on the output goes through here.  With KAUF_SINGLE_OUTPUT every light's output is a
+// KaufRGBWWLight, which is final, so the calls are direct instead of virtual and defaults like update_state()
+// inline away.
+#ifdef KAUF_SINGLE_OUTPUT
+static inline kauf_rgbww::KaufRGBWWLight *output_of(LightOutput *output) {
+  return static_cast<kauf_rgbww::KaufRGBWWLight *>(output);
+}
+#else
+static inline LightOutput *output_of(LightOutput *output) { return output; }
+#endif
+
 static const char *const TAG = "light";
 
+#ifdef USE_LIGHT_SCENES
+// KAUF: flash preference key of a light's scene slot 0, mixed with the light name.  Later slots count up from it.
+static const uint32_t SCENE_HASH = 0x4B534300UL;
+
+// KAUF: scene slots go to flash as LightSceneRecord, 9 words apart with the checksum word.
+static const uint32_t SCENE_RECORD_WORDS = sizeof(LightSceneRecord) / 4 + 1;
+
+static uint16_t scene_unit(float value) { return uint16_t(lroundf(clamp(value, 0.0f, 1.0f) * 65535.0f)); }
+
+static LightSceneRecord scene_to_record(const LightSceneSlot &scene) {
+  const LightColorValues &v = scene.values;
+  LightSceneRecord record{};
+  record.state = scene_unit(v.get_state());
+  record.brightness = scene_unit(v.get_brightness());
+  record.color_brightness = scene_unit(v.get_color_brightness());
+  record.red = scene_unit(v.get_red());
+  record.green = scene_unit(v.get_green());
+  record.blue = scene_unit(v.get_blue());
+  record.white = scene_unit(v.get_white());
+  record.cold_white = scene_unit(v.get_cold_white());
+  record.warm_white = scene_unit(v.get_warm_white());
+  record.color_temperature = uint16_t(lroundf(clamp(v.get_color_temperature() * 64.0f, 0.0f, 65535.0f)));
+  for (uint8_t i = 0; i < LIGHT_SCENE_LEVELS; i++)
+    record.levels[i] = scene_unit(scene.levels[i]);
+  record.color_mode = static_cast<uint8_t>(v.get_color_mode());
+  record.flags = (scene.stored ? LightSceneRecord::FLAG_STORED : 0) |
+                 (scene.has_levels ? LightSceneRecord::FLAG_HAS_LEVELS : 0);
+  return record;
+}
+
+static LightSceneSlot record_to_scene(const LightSceneRecord &record) {
+  LightSceneSlot scene{};
+  scene.values = LightColorValues(static_cast<ColorMode>(record.color_mode), record.state / 65535.0f,
+                                  record.brightness / 65535.0f, record.color_brightness / 65535.0f,
+                                  record.red / 65535.0f, record.green / 65535.0f, record.blue / 65535.0f,
+                                  record.white / 65535.0f, record.color_temperature / 64.0f,
+                                  record.cold_white / 65535.0f, record.warm_white / 65535.0f);
+  for (uint8_t i = 0; i < LIGHT_SCENE_LEVELS; i++)
+    scene.levels[i] = record.levels[i] / 65535.0f;
+  scene.stored = record.flags & LightSceneRecord::FLAG_STORED;
+  scene.has_levels = record.flags & LightSceneRecord::FLAG_HAS_LEVELS;
+  return scene;
+}
+#endif  // USE_LIGHT_SCENES
+
 LightState::LightState(LightOutput *output) : output_(output) {}
 
-LightTraits LightState::get_traits() { return this->output_->get_traits(); }
+const LightTraits &LightState::get_traits() {
+  // KAUF: anything asking before setup() gets a fresh copy, setup() then locks the cache in.
+  if (!this->traits_cached_)
+    this->traits_ = output_of(this->output_)->get_traits();
+  return this->traits_;
+}
 LightCall LightState::turn_on() { return this->make_call().set_state(true); }
 LightCall LightState::turn_off() { return this->make_call().set_state(false); }
-LightCall LightState::toggle() { return this->make_call().set_state(!this->remote_values.is_on()); }
+LightCall LightState::toggle() {
+#ifdef USE_LIGHT_COALESCE
+  this->flush_coalesced_call();  // KAUF: toggle from the state the last call asked for
+#endif
+  return this->make_call().set_state(!this->remote_values.is_on());
+}
 LightCall LightState::make_call() { return LightCall(this); }
 
 void LightState::setup() {
-  this->output_->setup_state(this);
+  // KAUF: traits are fixed from here on, build them once instead of on every call/validation.
+  this->traits_ = output_of(this->output_)->get_traits();
+  this->traits_cached_ = true;
+
+  output_of(this->output_)->setup_state(this);
   for (auto *effect : this->effects_) {
     effect->init_internal(this);
   }
@@ -31,7 +108,7 @@ void LightState::setup() {
   this->disable_loop_if_idle_();
 
   // When supported color temperature range is known, initialize color temperature setting within bounds.
-  auto traits = this->get_traits();
+  const auto &traits = this->get_traits();
   float min_mireds = traits.get_min_mireds();
   if (min_mireds > 0) {
     this->remote_values.set_color_temperature(min_mireds);
@@ -49,13 +126,46 @@ void LightState::setup() {
   else
     this->rtc_ = this->make_entity_preference<LightStateRTCState>();
 
+#ifdef USE_LIGHT_SCENES
+  // KAUF: scenes are held in RAM so a recall never waits on flash, flash only keeps them across power cycles.
+  if (this->scene_slots_ > 0) {
+    // the main light's name is "", so prefer the forced hash to tell lights apart
+    const uint32_t key = this->forced_hash != 0 ? this->forced_hash : fnv1_hash(this->get_name().c_str());
+    const uint32_t base = key ^ SCENE_HASH;
+    this->scenes_ = make_unique<LightSceneSlot[]>(this->scene_slots_);
+    this->scene_prefs_ = make_unique<ESPPreferenceObject[]>(this->scene_slots_);
+    for (uint8_t i = 0; i < this->scene_slots_; i++) {
+#ifdef USE_ESP8266
+      // forced addresses, kept clear of the rest in the reserved flash map (kauf-bulb.yaml)
+      this->scene_prefs_[i] = global_preferences->make_preference<LightSceneRecord>(
+          base + i, this->scene_addr_ + i * SCENE_RECORD_WORDS);
+#else
+      this->scene_prefs_[i] = global_preferences->make_preference<LightSceneRecord>(base + i, true);
+#endif
+      LightSceneRecord record;
+      this->scenes_[i] = this->scene_prefs_[i].load(&record) ? record_to_scene(record) : LightSceneSlot{};
+    }
+  }
+#endif
+
   this->restore_with_mode();
 
+#ifdef KAUF_OUTPUT_HANDOFF
+  // KAUF: warm reset with the pre-reset levels already on the hardware, don't write the restored values over them,
+  // neither here nor from the write the restore left pending for loop().
+  if (output_of(this->output_)->has_handoff_levels()) {
+    this->next_write_ = false;
+    this->disable_loop_if_idle_();
+    return;
+  }
+#endif
+
   // KAUF: Write to hardware immediately during setup so PWM outputs start
   // before WiFi and other lower-priority components finish their setup().
   // Without this, write_state() is deferred to loop() which doesn't run
   // until all components complete setup.
-  this->output_->write_state(this);
+  this->current_values_generation_++;
+  KAUF_PROFILE_CALL(PROFILE_WRITE_STATE, output_of(this->output_)->write_state(this));
 }
 
 
@@ -103,7 +213,7 @@ void LightState::restore_with_mode(uint32_t transition_length) {
   }
 
   // KAUF: default unknown startup mode to CT.
-  auto traits = this->get_traits();
+  const auto &traits = this->get_traits();
   if (recovered.color_mode == ColorMode::UNKNOWN) {
     recovered.color_mode = ColorMode::COLOR_TEMPERATURE;
     recovered.color_temp = traits.get_min_mireds();
@@ -145,7 +255,7 @@ void LightState::restore_with_mode(uint32_t transition_length) {
 }
 void LightState::dump_config() {
   ESP_LOGCONFIG(TAG, "Light '%s'", this->get_name().c_str());
-  auto traits = this->get_traits();
+  const auto &traits = this->get_traits();
   if (traits.supports_color_capability(ColorCapability::BRIGHTNESS)) {
     ESP_LOGCONFIG(TAG,
                   "  Default Transition Length: %.1fs\n"
@@ -158,12 +268,49 @@ void LightState::dump_config() {
                   "  Max Mireds: %.1f",
                   traits.get_min_mireds(), traits.get_max_mireds());
   }
+#ifdef USE_LIGHT_PUBLISH_SCHEDULER
+  if (this->publish_scheduled_) {
+    ESP_LOGCONFIG(TAG, "  Publish Interval: %" PRIu32 " ms, suppressed %" PRIu32, this->publish_interval_,
+                  this->publish_suppressed_);
+  }
+#endif
+#ifdef USE_LIGHT_COALESCE
+  if (this->coalesce_calls_) {
+    ESP_LOGCONFIG(TAG, "  Coalesce Calls: merged %" PRIu32 ", dropped %" PRIu32, this->coalesce_merged_,
+                  this->coalesce_dropped_);
+  }
+#endif
+#ifdef USE_LIGHT_SCENES
+  if (this->scene_slots_ > 0) {
+    uint8_t stored = 0;
+    for (uint8_t i = 0; i < this->scene_slots_; i++) {
+      if (this->scenes_[i].stored)
+        stored++;
+    }
+    ESP_LOGCONFIG(TAG, "  Scene Slots: %u (%u stored)", this->scene_slots_, stored);
+  }
+#endif
 }
 void LightState::loop() {
+  KAUF_PROFILE_SCOPE(PROFILE_LOOP);
+
+#ifdef USE_LIGHT_COALESCE
+  // KAUF: perform whatever the last loop's burst of calls added up to
+  this->flush_coalesced_call();
+#endif
+
+#ifdef USE_LIGHT_PUBLISH_SCHEDULER
+  // KAUF: deferred publish, once the minimum interval is up
+  if (this->publish_pending_ && millis() - this->last_publish_ >= this->publish_interval_) {
+    this->publish_state();
+    this->disable_loop_if_idle_();
+  }
+#endif
+
   // Apply effect (if any)
   auto *effect = this->get_active_effect_();
   if (effect != nullptr) {
-    effect->apply();
+    effect->apply_frame(millis());
   }
 
   // KAUF: run wled / ddp functions if enabled
@@ -186,17 +333,28 @@ void LightState::loop() {
 
   // Apply transformer (if any)
   if (this->transformer_ != nullptr) {
-    auto values = this->transformer_->apply();
+    auto values = KAUF_PROFILE_CALL(PROFILE_TRANSFORMER_APPLY, this->transformer_->apply());
     this->is_transformer_active_ = true;
     if (values.has_value()) {
       this->current_values = *values;
-      this->output_->update_state(this);
+      output_of(this->output_)->update_state(this);
+#ifdef KAUF_TIMED_TRANSITIONS
+      // KAUF: the output's timer is already stepping the hardware through this transition
+      if (!this->timed_transition_)
+#endif
       this->next_write_ = true;
     }
 
     if (this->transformer_->is_finished()) {
       // if the transition has written directly to the output, current_values is outdated, so update it
       this->current_values = this->transformer_->get_target_values();
+#ifdef KAUF_TIMED_TRANSITIONS
+      // KAUF: land on the exact target with a regular write
+      if (this->timed_transition_) {
+        this->end_timed_transition_();
+        this->next_write_ = true;
+      }
+#endif
 
       this->transformer_->stop();
       this->is_transformer_active_ = false;
@@ -213,22 +371,23 @@ void LightState::loop() {
   }
 
 #ifdef KAUF_HAS_AUX
-  // KAUF: check if aux lights have changed and refresh main light if so.
-  if ( !this->output_->is_aux() ) {
-    if ( (this->output_->warm_rgb != nullptr && this->output_->warm_rgb->has_changed) ||
-         (this->output_->cold_rgb != nullptr && this->output_->cold_rgb->has_changed) ) {
-      ESP_LOGV("KAUF_OUTPUT","warm or cold rgb changed");
-      if (this->output_->warm_rgb != nullptr) this->output_->warm_rgb->has_changed = false;
-      if (this->output_->cold_rgb != nullptr) this->output_->cold_rgb->has_changed = false;
-      this->next_write_ = true;
-    }
+  // KAUF: an aux light pushed a change (schedule_aux_write()), rewrite the mix with the same current values.
+  if (this->aux_write_ && !this->next_write_) {
+    this->aux_write_ = false;
+    ESP_LOGV("KAUF_OUTPUT", "warm or cold rgb changed");
+    KAUF_PROFILE_CALL(PROFILE_WRITE_STATE, output_of(this->output_)->write_state(this));
+    this->disable_loop_if_idle_();
   }
 #endif
 
   // Write state to the light
   if (this->next_write_) {
     this->next_write_ = false;
-    this->output_->write_state(this);
+#ifdef KAUF_HAS_AUX
+    this->aux_write_ = false;
+#endif
+    this->current_values_generation_++;
+    KAUF_PROFILE_CALL(PROFILE_WRITE_STATE, output_of(this->output_)->write_state(this));
     // Disable loop if idle (no transformer and no effect)
     this->disable_loop_if_idle_();
   }
@@ -258,14 +417,17 @@ void LightState::wled_apply() {
 
   std::vector<uint8_t> payload;
   while (uint16_t packet_size = udp_->parsePacket()) {
-    payload.resize(packet_size);
+    {
+      KAUF_PROFILE_SCOPE(PROFILE_WLED_RECEIVE);
+      payload.resize(packet_size);
 
-    if (!udp_->read(&payload[0], payload.size())) {
-      return;
-    }
+      if (!udp_->read(&payload[0], payload.size())) {
+        return;
+      }
 
-    if (!this->parse_frame_(&payload[0], payload.size())) {
-      return;
+      if (!this->parse_frame_(&payload[0], payload.size())) {
+        return;
+      }
     }
 
     // need at least 16 bytes to be able to forward anything.
@@ -274,6 +436,8 @@ void LightState::wled_apply() {
       return;
     }
 
+    KAUF_PROFILE_SCOPE(PROFILE_WLED_FORWARD);
+
     // get current ip address, quit if 254.  Not going to forward to 255.
     network::IPAddress addr = wifi::global_wifi_component->get_ip_addresses()[0];
     char ip_str[network::IP_ADDRESS_BUFFER_SIZE];
@@ -453,6 +617,35 @@ bool LightState::parse_frame_(const uint8_t *payload, uint16_t size) {
 float LightState::get_setup_priority() const { return setup_priority::HARDWARE - 1.0f; }
 
 void LightState::publish_state() {
+  // KAUF: covers remote_values changed from outside LightState (e.g. flash transformer restore)
+  this->remote_values_generation_++;
+
+#ifdef USE_LIGHT_PUBLISH_SCHEDULER
+  if (this->publish_scheduled_) {
+    // KAUF: too soon after the last publish, let loop() publish whatever it adds up to
+    if (this->has_published_ && millis() - this->last_publish_ < this->publish_interval_) {
+      if (!this->publish_pending_) {
+        this->publish_pending_ = true;
+        this->enable_loop();
+      }
+      return;
+    }
+    this->publish_pending_ = false;
+
+    // KAUF: nothing new since the last publish (e.g. random effect landing on the same values)
+    const uint16_t changes = this->compute_publish_changes_();
+    if (changes == 0) {
+      this->publish_suppressed_++;
+      return;
+    }
+    this->publish_changes_ = changes;
+    this->published_values_ = this->remote_values;
+    this->published_effect_index_ = this->active_effect_index_;
+    this->last_publish_ = millis();
+    this->has_published_ = true;
+  }
+#endif
+
   if (this->remote_values_listeners_) {
     for (auto *listener : *this->remote_values_listeners_) {
       listener->on_light_remote_values_update();
@@ -461,8 +654,42 @@ void LightState::publish_state() {
 #if defined(USE_LIGHT) && defined(USE_CONTROLLER_REGISTRY)
   ControllerRegistry::notify_light_update(this);
 #endif
+
+#ifdef USE_LIGHT_PUBLISH_SCHEDULER
+  this->publish_changes_ = LIGHT_PUBLISH_ALL;  // anyone asking outside a publish gets everything
+#endif
 }
 
+#ifdef USE_LIGHT_PUBLISH_SCHEDULER
+uint16_t LightState::compute_publish_changes_() {
+  if (!this->has_published_)
+    return LIGHT_PUBLISH_ALL;
+
+  const auto &a = this->remote_values;
+  const auto &b = this->published_values_;
+  uint16_t changes = 0;
+  if (a.is_on() != b.is_on())
+    changes |= LIGHT_PUBLISH_STATE;
+  if (a.get_brightness() != b.get_brightness())
+    changes |= LIGHT_PUBLISH_BRIGHTNESS;
+  if (a.get_color_brightness() != b.get_color_brightness())
+    changes |= LIGHT_PUBLISH_COLOR_BRIGHTNESS;
+  if (a.get_red() != b.get_red() || a.get_green() != b.get_green() || a.get_blue() != b.get_blue())
+    changes |= LIGHT_PUBLISH_RGB;
+  if (a.get_white() != b.get_white())
+    changes |= LIGHT_PUBLISH_WHITE;
+  if (a.get_color_temperature() != b.get_color_temperature())
+    changes |= LIGHT_PUBLISH_COLOR_TEMPERATURE;
+  if (a.get_cold_white() != b.get_cold_white() || a.get_warm_white() != b.get_warm_white())
+    changes |= LIGHT_PUBLISH_COLD_WARM_WHITE;
+  if (a.get_color_mode() != b.get_color_mode())
+    changes |= LIGHT_PUBLISH_COLOR_MODE;
+  if (this->active_effect_index_ != this->published_effect_index_)
+    changes |= LIGHT_PUBLISH_EFFECT;
+  return changes;
+}
+#endif
+
 LightOutput *LightState::get_output() const { return this->output_; }
 
 static constexpr auto EFFECT_NONE_REF = StringRef::from_lit("None");
@@ -533,7 +760,7 @@ void LightState::current_values_as_rgbww(float *red, float *green, float *blue,
 }
 void LightState::current_values_as_rgbct(float *red, float *green, float *blue, float *color_temperature,
                                          float *white_brightness) {
-  auto traits = this->get_traits();
+  const auto &traits = this->get_traits();
   this->current_values.as_rgbct(traits.get_min_mireds(), traits.get_max_mireds(), red, green, blue, color_temperature,
                                 white_brightness);
   *red = this->gamma_correct_lut(*red);
@@ -583,7 +810,7 @@ void LightState::current_values_as_cwww(float *cold_white, float *warm_white, bo
   *warm_white = white_level * std::max(cw_level, ww_level) * ww_level / sum;
 }
 void LightState::current_values_as_ct(float *color_temperature, float *white_brightness) {
-  auto traits = this->get_traits();
+  const auto &traits = this->get_traits();
   this->current_values.as_ct(traits.get_min_mireds(), traits.get_max_mireds(), color_temperature, white_brightness);
   *white_brightness = this->gamma_correct_lut(*white_brightness);
 }
@@ -610,19 +837,26 @@ float LightState::gamma_uncorrect_lut(float value) const {
     return 0.0f;
   if (value >= 1.0f)
     return 1.0f;
-  if (this->gamma_table_ == nullptr)
+  if (this->gamma_reverse_table_ == nullptr)
     return value;
-  uint16_t target = static_cast<uint16_t>(value * 65535.0f);
-  uint8_t lo = gamma_table_reverse_search(this->gamma_table_, target);
-  if (lo >= 255)
-    return 1.0f;
-  // Interpolate between lo and lo+1
-  uint16_t a = progmem_read_uint16(&this->gamma_table_[lo]);
-  uint16_t b = progmem_read_uint16(&this->gamma_table_[lo + 1]);
-  if (b == a)
-    return lo / 255.0f;
-  float frac = static_cast<float>(target - a) / static_cast<float>(b - a);
-  return (lo + frac) / 255.0f;
+  float scaled = value * 255.0f;
+  auto idx = static_cast<uint8_t>(scaled);
+  if (idx == 0) {
+    // KAUF: below 1/255 the curve is too steep to interpolate, search the forward LUT there
+    uint16_t target = static_cast<uint16_t>(value * 65535.0f);
+    uint8_t lo = gamma_table_reverse_search(this->gamma_table_, target);
+    uint16_t a = progmem_read_uint16(&this->gamma_table_[lo]);
+    uint16_t b = progmem_read_uint16(&this->gamma_table_[lo + 1]);
+    if (b == a)
+      return lo / 255.0f;
+    return (lo + static_cast<float>(target - a) / static_cast<float>(b - a)) / 255.0f;
+  }
+  if (idx >= 255)
+    return progmem_read_uint16(&this->gamma_reverse_table_[255]) / 65535.0f;
+  float frac = scaled - idx;
+  float a = progmem_read_uint16(&this->gamma_reverse_table_[idx]);
+  float b = progmem_read_uint16(&this->gamma_reverse_table_[idx + 1]);
+  return (a + frac * (b - a)) / 65535.0f;
 }
 #endif  // USE_LIGHT_GAMMA_LUT
 
@@ -634,6 +868,7 @@ void LightState::start_effect_(uint32_t effect_index) {
     return;
 
   this->active_effect_index_ = effect_index;
+  this->remote_values_generation_++;
   auto *effect = this->get_active_effect_();
   effect->start_internal();
   // Enable loop while effect is active
@@ -651,17 +886,28 @@ void LightState::stop_effect_() {
   if (effect != nullptr) {
     effect->stop();
   }
+  if (this->active_effect_index_ != 0)
+    this->remote_values_generation_++;
   this->active_effect_index_ = 0;
   // Disable loop if idle (no effect and no transformer)
   this->disable_loop_if_idle_();
 }
 
 void LightState::start_transition_(const LightColorValues &target, uint32_t length, bool set_remote_values) {
-  this->transformer_ = this->output_->create_default_transition();
+#ifdef KAUF_TIMED_TRANSITIONS
+  this->end_timed_transition_();
+#endif
+  this->transformer_ = output_of(this->output_)->create_default_transition();
   this->transformer_->setup(this->current_values, target, length);
+#ifdef KAUF_TIMED_TRANSITIONS
+  // KAUF: DDP writes raw values over whatever the transition does, leave those to loop()
+  if (!this->use_wled_)
+    this->timed_transition_ = output_of(this->output_)->start_timed_transition(this, this->transformer_.get(), length);
+#endif
 
   if (set_remote_values) {
     this->remote_values = target;
+    this->remote_values_generation_++;
   }
   // Enable loop while transition is active
   this->enable_loop();
@@ -674,36 +920,235 @@ void LightState::start_flash_(const LightColorValues &target, uint32_t length, b
   if (this->transformer_ != nullptr)
     end_colors = this->transformer_->get_start_values();
 
+#ifdef KAUF_TIMED_TRANSITIONS
+  this->end_timed_transition_();
+#endif
   this->transformer_ = make_unique<LightFlashTransformer>(*this);
   this->transformer_->setup(end_colors, target, length);
 
   if (set_remote_values) {
     this->remote_values = target;
+    this->remote_values_generation_++;
   };
   // Enable loop while flash is active
   this->enable_loop();
 }
 
 void LightState::set_immediately_(const LightColorValues &target, bool set_remote_values) {
+#ifdef KAUF_TIMED_TRANSITIONS
+  this->end_timed_transition_();
+#endif
   this->is_transformer_active_ = false;
   this->transformer_ = nullptr;
   this->current_values = target;
   if (set_remote_values) {
     this->remote_values = target;
+    this->remote_values_generation_++;
   }
-  this->output_->update_state(this);
+  output_of(this->output_)->update_state(this);
   this->schedule_write_();
 }
 
+#ifdef KAUF_TIMED_TRANSITIONS
+void LightState::end_timed_transition_() {
+  if (!this->timed_transition_)
+    return;
+  this->timed_transition_ = false;
+  output_of(this->output_)->stop_timed_transition();
+}
+#endif
+
+void LightState::write_effect_values_(const LightColorValues &values, bool transition) {
+  if (this->transformer_ != nullptr) {
+#ifdef KAUF_TIMED_TRANSITIONS
+    this->end_timed_transition_();
+#endif
+    this->transformer_ = nullptr;
+  } else if (values == this->current_values && transition == this->is_transformer_active_ &&
+             !this->current_values.use_raw) {
+    return;
+  }
+  this->is_transformer_active_ = transition;
+  this->current_values = values;
+  output_of(this->output_)->update_state(this);
+  this->next_write_ = true;  // loop() is running while an effect is active
+}
+
+#ifdef USE_LIGHT_COALESCE
+void LightState::coalesce_call_(const LightCall &call) {
+  if (this->has_pending_call_) {
+    this->coalesce_merged_++;
+  } else {
+    // a new LightCall saves by default, start without it so only the merged calls decide
+    this->pending_call_ = LightCall(this);
+    this->pending_call_.set_save(false);
+    this->has_pending_call_ = true;
+    this->enable_loop();
+  }
+  this->pending_call_.merge_(call);
+}
+
+void LightState::flush_coalesced_call() {
+  if (!this->has_pending_call_)
+    return;
+  this->has_pending_call_ = false;
+
+  // work on a copy, triggers fired while performing may start coalescing the next call
+  LightCall call = this->pending_call_;
+  LightColorValues v = call.validate_();
+
+  // nothing to do if the burst ended up asking for the current target, e.g. a slider dragged back
+  if (!call.has_effect_() && v == this->remote_values) {
+    this->coalesce_dropped_++;
+    ESP_LOGV(TAG, "'%s': dropped no-op call (%" PRIu32 " merged, %" PRIu32 " dropped)", this->get_name().c_str(),
+             this->coalesce_merged_, this->coalesce_dropped_);
+    return;
+  }
+
+  call.execute_(v);
+}
+#endif
+
+#ifdef USE_LIGHT_RAMP
+void LightState::start_ramp(LightRampField field, float rate, float min, float max) {
+#ifdef USE_LIGHT_COALESCE
+  this->flush_coalesced_call();  // ramp from what the last call asked for
+#endif
+  if (rate == 0.0f)
+    return;
+
+  LightColorValues start = this->remote_values;
+  const auto &traits = this->get_traits();
+  if (field == LightRampField::BRIGHTNESS) {
+    if (!(start.get_color_mode() & ColorCapability::BRIGHTNESS))
+      return;
+    if (!start.is_on()) {
+      if (rate < 0.0f)
+        return;  // already as dim as it gets
+      start.set_state(true);
+      start.set_brightness(min);
+    }
+    start.set_brightness(clamp(start.get_brightness(), min, max));
+  } else {
+    if (!(start.get_color_mode() & ColorCapability::COLOR_TEMPERATURE) || !start.is_on())
+      return;
+    min = std::max(min, traits.get_min_mireds());
+    max = std::min(max, traits.get_max_mireds());
+    start.set_color_temperature(clamp(start.get_color_temperature(), min, max));
+  }
+
+  this->stop_effect_();
+#ifdef KAUF_TIMED_TRANSITIONS
+  this->end_timed_transition_();
+#endif
+  this->transformer_ = make_unique<LightRampTransformer>(*this, field, rate, min, max);
+  this->transformer_->setup(this->current_values, start, 0);
+  ESP_LOGV(TAG, "'%s': ramp started, rate %.3f/s", this->get_name().c_str(), rate);
+  this->enable_loop();
+}
+
+void LightState::stop_ramp() {
+  if (this->transformer_ != nullptr)
+    this->transformer_->finish();
+}
+#endif
+
+#ifdef USE_LIGHT_SCENES
+bool LightState::store_scene(uint8_t slot) {
+  if (slot >= this->scene_slots_) {
+    ESP_LOGW(TAG, "'%s': no scene slot %u", this->get_name().c_str(), slot);
+    return false;
+  }
+#ifdef USE_LIGHT_COALESCE
+  this->flush_coalesced_call();  // store what the last call asked for
+#endif
+
+  auto &scene = this->scenes_[slot];
+  scene.values = this->remote_values;
+  scene.values.use_raw = false;
+  scene.stored = true;
+  // the outputs only hold the levels for remote_values once nothing else is driving them
+  scene.has_levels = this->transformer_ == nullptr && this->get_active_effect_() == nullptr && !this->next_write_ &&
+                     !this->use_wled_ && output_of(this->output_)->capture_levels(this, scene.levels);
+  const LightSceneRecord record = scene_to_record(scene);
+  this->scene_prefs_[slot].save(&record);
+
+  ESP_LOGD(TAG, "'%s': stored scene %u%s", this->get_name().c_str(), slot,
+           scene.has_levels ? "" : ", levels are mixed on recall");
+  return true;
+}
+
+bool LightState::recall_scene(uint8_t slot, optional<uint32_t> transition_length, bool save) {
+  if (!this->has_scene(slot)) {
+    ESP_LOGW(TAG, "'%s': scene %u is not stored", this->get_name().c_str(), slot);
+    return false;
+  }
+#ifdef USE_LIGHT_COALESCE
+  this->flush_coalesced_call();  // don't let an older pending call land on top of the scene
+#endif
+
+  // values were validated when stored, so this is the tail end of LightCall::execute_() without validate_()
+  const auto &scene = this->scenes_[slot];
+  this->stop_effect_();
+
+  uint32_t length = transition_length.value_or(this->default_transition_length_);
+  if (!(scene.values.get_color_mode() & ColorCapability::BRIGHTNESS))
+    length = 0;
+
+  if (length != 0) {
+    this->start_transition_(scene.values, length, true);
+  } else {
+#ifdef KAUF_TIMED_TRANSITIONS
+    this->end_timed_transition_();
+#endif
+    this->is_transformer_active_ = false;
+    this->transformer_ = nullptr;
+    this->current_values = scene.values;
+    this->remote_values = scene.values;
+    this->remote_values_generation_++;
+    output_of(this->output_)->update_state(this);
+
+    // replay the stored levels instead of mixing them again, write_state() in loop() if the output can't
+    this->current_values_generation_++;
+    if (scene.has_levels && output_of(this->output_)->apply_levels(this, scene.levels)) {
+      this->next_write_ = false;
+      this->disable_loop_if_idle_();
+    } else {
+      this->schedule_write_();
+    }
+
+    if (this->target_state_reached_listeners_) {
+      for (auto *listener : *this->target_state_reached_listeners_) {
+        listener->on_light_target_state_reached();
+      }
+    }
+  }
+
+  ESP_LOGV(TAG, "'%s': recalled scene %u, transition %" PRIu32 " ms", this->get_name().c_str(), slot, length);
+  this->publish_state();
+  if (save)
+    this->save_remote_values_();
+  return true;
+}
+#endif
+
 void LightState::disable_loop_if_idle_() {
   // Only disable loop if both transformer and effect are inactive, and no pending writes
   // KAUF: and if not using WLED/DDP
-  if (this->transformer_ == nullptr && this->get_active_effect_() == nullptr && !this->next_write_ && !this->use_wled_) {
+  if (this->transformer_ == nullptr && this->get_active_effect_() == nullptr && !this->next_write_ && !this->use_wled_
+#ifdef USE_LIGHT_COALESCE
+      && !this->has_pending_call_
+#endif
+#ifdef USE_LIGHT_PUBLISH_SCHEDULER
+      && !this->publish_pending_
+#endif
+  ) {
     this->disable_loop();
   }
 }
 
 void LightState::save_remote_values_() {
+  KAUF_PROFILE_SCOPE(PROFILE_SAVE_REMOTE);
 
   // KAUF: don't actually save if not in a saving mode
   if ( (this->restore_mode_ != LIGHT_ALWAYS_OFF) && (this->restore_mode_ != LIGHT_ALWAYS_ON) ) {
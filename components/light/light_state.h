@@ -8,6 +8,9 @@
 #include "light_call.h"
 #include "light_color_values.h"
 #include "light_effect.h"
+#ifdef USE_JSON
+#include "json_state.h"
+#endif
 #include "light_traits.h"
 #include "light_transformer.h"
 
@@ -41,6 +44,29 @@ class LightRemoteValuesListener {
   virtual void on_light_remote_values_update() = 0;
 };
 
+#ifdef USE_LIGHT_PUBLISH_SCHEDULER
+/** KAUF: bits reported by LightState::get_publish_changes() while listeners run, so front-ends can
+ * send only what changed since the last publish.
+ */
+enum LightPublishField : uint16_t {
+  LIGHT_PUBLISH_STATE = 1 << 0,
+  LIGHT_PUBLISH_BRIGHTNESS = 1 << 1,
+  LIGHT_PUBLISH_COLOR_BRIGHTNESS = 1 << 2,
+  LIGHT_PUBLISH_RGB = 1 << 3,
+  LIGHT_PUBLISH_WHITE = 1 << 4,
+  LIGHT_PUBLISH_COLOR_TEMPERATURE = 1 << 5,
+  LIGHT_PUBLISH_COLD_WARM_WHITE = 1 << 6,
+  LIGHT_PUBLISH_COLOR_MODE = 1 << 7,
+  LIGHT_PUBLISH_EFFECT = 1 << 8,
+  LIGHT_PUBLISH_ALL = 0x01FF,
+};
+#endif
+
+#ifdef USE_LIGHT_RAMP
+/// KAUF: what a light.ramp_start action changes.
+enum class LightRampField : uint8_t { BRIGHTNESS, COLOR_TEMPERATURE };
+#endif
+
 /** Listener interface for light target state reached.
  *
  * Components can implement this interface to receive notifications
@@ -95,6 +121,42 @@ struct LightStateRTCState {
   bool state{false};
 };
 
+#ifdef USE_LIGHT_SCENES
+/// KAUF: red, green, blue, cold white, warm white.
+static const uint8_t LIGHT_SCENE_LEVELS = 5;
+
+/// KAUF: one stored scene, kept in RAM.  values were validated when the scene was stored, levels are what the
+/// output wrote for them (see LightOutput::capture_levels()).
+struct LightSceneSlot {
+  LightColorValues values;
+  float levels[LIGHT_SCENE_LEVELS];
+  bool has_levels{false};
+  bool stored{false};
+};
+
+/// KAUF: a LightSceneSlot as kept in flash.  Units and levels in 1/65535, color temperature in 1/64 mired, which
+/// is finer than the PWM the levels end up on.  8 words, so 9 with the checksum on ESP8266 (see scene_addr).
+struct LightSceneRecord {
+  static const uint8_t FLAG_STORED = 1 << 0;
+  static const uint8_t FLAG_HAS_LEVELS = 1 << 1;
+
+  uint16_t state;
+  uint16_t brightness;
+  uint16_t color_brightness;
+  uint16_t red;
+  uint16_t green;
+  uint16_t blue;
+  uint16_t white;
+  uint16_t cold_white;
+  uint16_t warm_white;
+  uint16_t color_temperature;
+  uint16_t levels[LIGHT_SCENE_LEVELS];
+  uint8_t color_mode;
+  uint8_t flags;
+};
+static_assert(sizeof(LightSceneRecord) == 32, "scene_addr spacing in light/__init__.py assumes 8 words");
+#endif
+
 /** This class represents the communication layer between the front-end MQTT layer and the
  * hardware output layer.
  */
@@ -102,10 +164,8 @@ class LightState : public EntityBase, public Component {
  public:
   LightState(LightOutput *output);
 
-  LightTraits get_traits();
-
-  // KAUF: lets the main light know whether the aux light has changed so it can update if so.
-  bool has_changed = false;
+  /// Get the traits of this light.  KAUF: built once in setup() and cached, traits never change afterwards.
+  const LightTraits &get_traits();
 
   /// Make a light state call
   LightCall turn_on();
@@ -177,6 +237,34 @@ class LightState : public EntityBase, public Component {
   /// Publish the currently active state to the frontend.
   void publish_state();
 
+  /// KAUF: changes whenever remote_values or the active effect may have changed, for caching what is derived from them.
+  uint32_t get_remote_values_generation() const { return this->remote_values_generation_; }
+
+  /// KAUF: bumped every time current_values go to the output (0 until the first write), so an output can cache
+  /// what it derives from them.
+  uint32_t get_current_values_generation() const { return this->current_values_generation_; }
+
+#ifdef KAUF_HAS_AUX
+  /// KAUF: an aux light feeding this light's output changed.  Rewrites the output in the next loop without
+  /// bumping the current values generation, since current_values didn't change.
+  void schedule_aux_write() {
+    this->aux_write_ = true;
+    this->enable_loop();
+  }
+#endif
+
+#ifdef USE_LIGHT_PUBLISH_SCHEDULER
+  /// KAUF: publish at most once per interval (ms), later publishes are deferred to loop() and merged.
+  void set_publish_interval(uint32_t publish_interval) {
+    this->publish_interval_ = publish_interval;
+    this->publish_scheduled_ = true;
+  }
+  /// KAUF: LightPublishField bits that changed since the previous publish, valid while listeners are notified.
+  uint16_t get_publish_changes() const { return this->publish_changes_; }
+  /// KAUF: number of publishes skipped because nothing changed since the previous one.
+  uint32_t get_publish_suppressed_count() const { return this->publish_suppressed_; }
+#endif
+
   /// Get the light output associated with this object.
   LightOutput *get_output() const;
 
@@ -208,15 +296,22 @@ class LightState : public EntityBase, public Component {
   float get_gamma_correct() const { return this->gamma_correct_; }
 
 #ifdef USE_LIGHT_GAMMA_LUT
-  /// Set pre-computed gamma forward lookup table (256-entry uint16 PROGMEM array)
-  void set_gamma_table(const uint16_t *forward) { this->gamma_table_ = forward; }
+  /// Set pre-computed gamma lookup tables (256-entry PROGMEM arrays). KAUF: reverse tables generated with the
+  /// forward one, indexed by corrected value, so uncorrect is a lookup instead of a search.
+  void set_gamma_table(const uint16_t *forward, const uint16_t *reverse, const uint8_t *reverse8) {
+    this->gamma_table_ = forward;
+    this->gamma_reverse_table_ = reverse;
+    this->gamma_reverse8_table_ = reverse8;
+  }
 
   /// Get the forward gamma lookup table
   const uint16_t *get_gamma_table() const { return this->gamma_table_; }
+  /// KAUF: get the uint8 reverse gamma lookup table
+  const uint8_t *get_gamma_reverse8_table() const { return this->gamma_reverse8_table_; }
 
   /// Apply gamma correction using the pre-computed forward LUT
   float gamma_correct_lut(float value) const;
-  /// Reverse gamma correction by binary-searching the forward LUT
+  /// Reverse gamma correction using the pre-computed reverse LUT
   float gamma_uncorrect_lut(float value) const;
 #else
   /// No gamma LUT — passthrough
@@ -334,11 +429,46 @@ class LightState : public EntityBase, public Component {
   void set_forced_hash(uint32_t hash_value) { this->forced_hash = hash_value; }
   void set_forced_addr(uint32_t addr_value) { this->forced_addr = addr_value; }
 
+#ifdef USE_LIGHT_COALESCE
+  // KAUF: coalesce bursts of published calls into one pending call per light, performed once per loop().
+  void set_coalesce_calls(bool coalesce_calls) { this->coalesce_calls_ = coalesce_calls; }
+  /// Perform the pending coalesced call now, e.g. before reading remote_values for a relative change.
+  void flush_coalesced_call();
+  /// Number of calls merged into an already pending call.
+  uint32_t get_coalesce_merged_count() const { return this->coalesce_merged_; }
+  /// Number of flushed calls dropped because their target already matched remote_values.
+  uint32_t get_coalesce_dropped_count() const { return this->coalesce_dropped_; }
+#endif
+
+#ifdef USE_LIGHT_RAMP
+  /** KAUF: change brightness (per second, 1.0 = full range) or color temperature (mireds per second) at a constant
+   * rate until stop_ramp() or until min/max is reached.  The result is published and saved once when it ends.
+   */
+  void start_ramp(LightRampField field, float rate, float min, float max);
+  /// End a running ramp where it is.
+  void stop_ramp();
+#endif
+
+#ifdef USE_LIGHT_SCENES
+  // KAUF: scene slots, stored targets that are recalled without validation or mixing.
+  void set_scene_slots(uint8_t scene_slots) { this->scene_slots_ = scene_slots; }
+  /// ESP8266: flash word address of the first slot, the others follow 9 words apart.
+  void set_scene_addr(uint32_t scene_addr) { this->scene_addr_ = scene_addr; }
+  uint8_t get_scene_slots() const { return this->scene_slots_; }
+  bool has_scene(uint8_t slot) const { return slot < this->scene_slots_ && this->scenes_[slot].stored; }
+  /// Store the current target (remote_values) in a slot.  Returns false for a bad slot.
+  bool store_scene(uint8_t slot);
+  /// Go to a stored scene, with the default transition length if none is given.  Returns false if the slot is empty.
+  bool recall_scene(uint8_t slot, optional<uint32_t> transition_length = {}, bool save = true);
+#endif
 
  protected:
   friend LightOutput;
   friend LightCall;
+  friend class ConstantLightCall;
+  friend class LightEffect;
   friend class AddressableLight;
+  friend class LightJSONSchema;
 
   /// Internal method to start an effect with the given index
   void start_effect_(uint32_t effect_index);
@@ -355,11 +485,20 @@ class LightState : public EntityBase, public Component {
   /// Internal method to set the color values to target immediately (with no transition).
   void set_immediately_(const LightColorValues &target, bool set_remote_values);
 
+  /// KAUF: an effect frame, current_values only.  Skips the write if nothing changed since the last frame.
+  /// transition marks values in transition gamma space, is_transformer_active() reports it to the output.
+  void write_effect_values_(const LightColorValues &values, bool transition);
+
   // KAUF: moved save_remote_values_() to public functions
 
   /// Disable loop if neither transformer nor effect is active
   void disable_loop_if_idle_();
 
+#ifdef KAUF_TIMED_TRANSITIONS
+  /// KAUF: hand the output's timed transition back, before the transformer is replaced or dropped.
+  void end_timed_transition_();
+#endif
+
   /// Schedule a write to the light output and enable the loop to process it
   void schedule_write_() {
     this->next_write_ = true;
@@ -368,6 +507,8 @@ class LightState : public EntityBase, public Component {
 
   /// Store the output to allow effects to have more access.
   LightOutput *output_;
+  /// KAUF: traits cached from the output in setup(), see get_traits().
+  LightTraits traits_;
   /// The currently active transformer for this light (transition/flash).
   std::unique_ptr<LightTransformer> transformer_{nullptr};
   /// List of effects for this light.
@@ -408,10 +549,64 @@ class LightState : public EntityBase, public Component {
   float gamma_correct_{};
 #ifdef USE_LIGHT_GAMMA_LUT
   const uint16_t *gamma_table_{nullptr};
+  const uint16_t *gamma_reverse_table_{nullptr};
+  const uint8_t *gamma_reverse8_table_{nullptr};
 #endif  // USE_LIGHT_GAMMA_LUT
 
+#ifdef USE_LIGHT_PUBLISH_SCHEDULER
+  /// KAUF: LightPublishField bits for what differs from the last published state.
+  uint16_t compute_publish_changes_();
+
+  LightColorValues published_values_{};
+  uint32_t published_effect_index_{0};
+  uint32_t last_publish_{0};
+  uint32_t publish_interval_{0};
+  uint32_t publish_suppressed_{0};
+  uint16_t publish_changes_{LIGHT_PUBLISH_ALL};
+  bool publish_scheduled_{false};
+  bool has_published_{false};
+  bool publish_pending_{false};
+#endif
+
+#ifdef USE_LIGHT_COALESCE
+  /// KAUF: merge a call into pending_call_ and make sure loop() runs to flush it.
+  void coalesce_call_(const LightCall &call);
+
+  LightCall pending_call_{this};
+  uint32_t coalesce_merged_{0};
+  uint32_t coalesce_dropped_{0};
+  bool coalesce_calls_{false};
+  bool has_pending_call_{false};
+#endif
+
+#ifdef USE_LIGHT_SCENES
+  std::unique_ptr<LightSceneSlot[]> scenes_;
+  std::unique_ptr<ESPPreferenceObject[]> scene_prefs_;
+  uint8_t scene_slots_{0};
+  uint32_t scene_addr_{0};
+#endif
+
+  /// KAUF: see get_remote_values_generation().
+  uint32_t remote_values_generation_{0};
+  /// KAUF: see get_current_values_generation().
+  uint32_t current_values_generation_{0};
+#ifdef USE_JSON
+  /// KAUF: JSON state values and text, filled by LightJSONSchema per remote values generation.
+  JsonStateCache json_cache_;
+#endif
+
   /// Whether the light value should be written in the next cycle.
   bool next_write_{true};
+#ifdef KAUF_HAS_AUX
+  /// KAUF: whether only an aux light changed and the output should be rewritten in the next cycle.
+  bool aux_write_{false};
+#endif
+#ifdef KAUF_TIMED_TRANSITIONS
+  /// KAUF: whether the output renders the active transformer from its timer, loop() then doesn't write its frames.
+  bool timed_transition_{false};
+#endif
+  /// KAUF: whether traits_ holds the final traits built in setup().
+  bool traits_cached_{false};
   // for effects, true if a transformer (transition) is active.
   bool is_transformer_active_{false};
   /// Restore mode of the light.
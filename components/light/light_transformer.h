@@ -32,6 +32,15 @@ class LightTransformer {
   /// This will be called after transition is finished.
   virtual void stop() {}
 
+  /// KAUF: end an open-ended transformer (ramp) at its current values.  Others always run their full length.
+  virtual void finish() {}
+
+#ifdef KAUF_TIMED_TRANSITIONS
+  /// KAUF: the values at progress (0 to 1) without looking at the clock, for outputs that render ahead.
+  /// Only plain transitions can be sampled, the others return false.
+  virtual bool sample(float progress, LightColorValues &values) { return false; }
+#endif
+
   const LightColorValues &get_start_values() const { return this->start_values_; }
 
   const LightColorValues &get_target_values() const { return this->target_values_; }
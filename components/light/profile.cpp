@@ -0,0 +1,118 @@
+#include <cinttypes>
+
+#include "profile.h"
+
+#ifdef KAUF_PROFILE
+#include "esphome/core/log.h"
+
+namespace esphome::light {
+
+static const char *const TAG = "light";
+
+// half-octave buckets from 16 cycles, the last one (2^27 cycles, over a second at 80 MHz) takes everything longer
+static constexpr uint8_t PROFILE_BUCKETS = 48;
+static constexpr uint8_t PROFILE_FIRST_OCTAVE = 4;
+
+static const char *const PROFILE_SITE_NAMES[PROFILE_SITE_COUNT] = {
+    "loop", "effect apply", "transformer apply", "write_state", "wled receive",
+    "wled forward", "call perform", "save remote", "dump json",
+};
+
+struct ProfileStats {
+  uint32_t calls;
+  uint32_t min;
+  uint32_t max;
+  uint64_t total;
+  // counts are halved together when one would overflow, which keeps the shape p99 is read from
+  uint16_t buckets[PROFILE_BUCKETS];
+};
+
+static ProfileStats profile_stats[PROFILE_SITE_COUNT]{};
+static uint32_t profile_window_start = 0;
+
+static uint8_t bucket_of(uint32_t cycles) {
+  if (cycles < (1u << PROFILE_FIRST_OCTAVE))
+    return 0;
+  const uint8_t msb = 31 - __builtin_clz(cycles);
+  const uint8_t bucket = (msb - PROFILE_FIRST_OCTAVE) * 2 + ((cycles >> (msb - 1)) & 1);
+  return bucket < PROFILE_BUCKETS ? bucket : PROFILE_BUCKETS - 1;
+}
+
+// largest cycle count that lands in bucket
+static uint32_t bucket_upper(uint8_t bucket) {
+  const uint8_t msb = bucket / 2 + PROFILE_FIRST_OCTAVE;
+  return (1u << msb) + ((uint32_t) ((bucket & 1) + 1) << (msb - 1)) - 1;
+}
+
+void profile_record(ProfileSite site, uint32_t cycles) {
+  ProfileStats &stats = profile_stats[site];
+  if (stats.calls == 0 || cycles < stats.min)
+    stats.min = cycles;
+  if (cycles > stats.max)
+    stats.max = cycles;
+  stats.calls++;
+  stats.total += cycles;
+
+  uint16_t &count = stats.buckets[bucket_of(cycles)];
+  if (count == UINT16_MAX) {
+    for (auto &bucket : stats.buckets)
+      bucket /= 2;
+  }
+  count++;
+}
+
+ProfileSummary profile_summary(ProfileSite site) {
+  const ProfileStats &stats = profile_stats[site];
+  ProfileSummary summary{};
+  if (stats.calls == 0)
+    return summary;
+
+  const float cycles_per_us = arch_get_cpu_freq_hz() / 1e6f;
+  summary.calls = stats.calls;
+  summary.min_us = stats.min / cycles_per_us;
+  summary.max_us = stats.max / cycles_per_us;
+  summary.avg_us = (float) stats.total / stats.calls / cycles_per_us;
+
+  uint32_t total = 0;
+  for (auto bucket : stats.buckets)
+    total += bucket;
+  const uint32_t needed = (total * 99 + 99) / 100;
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i < PROFILE_BUCKETS; i++) {
+    seen += stats.buckets[i];
+    if (seen >= needed) {
+      const uint32_t upper = bucket_upper(i);
+      summary.p99_us = (upper < stats.max ? upper : stats.max) / cycles_per_us;
+      break;
+    }
+  }
+
+  const uint32_t window = millis() - profile_window_start;
+  if (window > 0)
+    summary.rate_hz = stats.calls * 1000.0f / window;
+  return summary;
+}
+
+void profile_dump(bool reset) {
+  ESP_LOGI(TAG, "Profile over %.1f s, CPU %" PRIu32 " MHz (times in us):", (millis() - profile_window_start) / 1000.0f,
+           arch_get_cpu_freq_hz() / 1000000);
+  for (uint8_t i = 0; i < PROFILE_SITE_COUNT; i++) {
+    const ProfileSummary summary = profile_summary(static_cast<ProfileSite>(i));
+    if (summary.calls == 0)
+      continue;
+    ESP_LOGI(TAG, "  %-17s %8" PRIu32 " calls %8.1f Hz  min %8.1f  avg %8.1f  p99 %8.1f  max %8.1f",
+             PROFILE_SITE_NAMES[i], summary.calls, summary.rate_hz, summary.min_us, summary.avg_us, summary.p99_us,
+             summary.max_us);
+  }
+  if (reset)
+    profile_reset();
+}
+
+void profile_reset() {
+  for (auto &stats : profile_stats)
+    stats = ProfileStats{};
+  profile_window_start = millis();
+}
+
+}  // namespace esphome::light
+#endif
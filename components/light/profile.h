@@ -0,0 +1,88 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef KAUF_PROFILE
+#include "esphome/core/hal.h"
+#include <cstdint>
+#endif
+
+namespace esphome::light {
+
+#ifdef KAUF_PROFILE
+/** KAUF: cycle counter profiling of the light's hot paths, built with `profile: true` on a light.
+ *
+ * Each site keeps a fixed histogram of call lengths in half-octave buckets of CPU cycles, plus min, max, total and
+ * call count since the last reset.  p99 comes from the buckets, so it is the upper edge of the bucket holding the
+ * 99th percentile (clamped to max), good to about 50%.  Scopes nest, a site's time includes the sites it calls.
+ *
+ * Read it with the light.profile_dump action, or from a template sensor:
+ *
+ *     sensor:
+ *       - platform: template
+ *         name: Light Loop p99
+ *         unit_of_measurement: us
+ *         entity_category: diagnostic
+ *         lambda: return light::profile_summary(light::PROFILE_LOOP).p99_us;
+ */
+enum ProfileSite : uint8_t {
+  PROFILE_LOOP,               ///< LightState::loop()
+  PROFILE_EFFECT_APPLY,       ///< LightEffect::apply() for one frame
+  PROFILE_TRANSFORMER_APPLY,  ///< transformer_->apply() in loop()
+  PROFILE_WRITE_STATE,        ///< LightOutput::write_state()
+  PROFILE_WLED_RECEIVE,       ///< reading and parsing one DDP packet
+  PROFILE_WLED_FORWARD,       ///< forwarding the rest of a DDP packet to the next bulbs
+  PROFILE_CALL_PERFORM,       ///< LightCall::perform()
+  PROFILE_SAVE_REMOTE,        ///< LightState::save_remote_values_()
+  PROFILE_DUMP_JSON,          ///< LightJSONSchema::dump_json() and encode_json()
+  PROFILE_SITE_COUNT,
+};
+
+struct ProfileSummary {
+  uint32_t calls;  ///< since the last reset
+  float min_us;
+  float avg_us;
+  float p99_us;
+  float max_us;
+  float rate_hz;  ///< calls per second since the last reset
+};
+
+/// Add one call of cycles CPU cycles to site.
+void profile_record(ProfileSite site, uint32_t cycles);
+/// Summary of site since the last reset, all zero if it wasn't called.
+ProfileSummary profile_summary(ProfileSite site);
+/// Log every site's summary, then reset them all if reset is set.
+void profile_dump(bool reset);
+/// Clear every site and restart the call rate window.
+void profile_reset();
+
+/// Times its own lifetime into a site.
+class ProfileScope {
+ public:
+  explicit ProfileScope(ProfileSite site) : site_(site), start_(arch_get_cpu_cycle_count()) {}
+  ~ProfileScope() { profile_record(this->site_, arch_get_cpu_cycle_count() - this->start_); }
+
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope &operator=(const ProfileScope &) = delete;
+
+ protected:
+  ProfileSite site_;
+  uint32_t start_;
+};
+
+#define KAUF_PROFILE_CONCAT_(a, b) a##b
+#define KAUF_PROFILE_NAME_(line) KAUF_PROFILE_CONCAT_(kauf_profile_scope_, line)
+/// Profile the rest of the enclosing block into site.
+#define KAUF_PROFILE_SCOPE(site) ::esphome::light::ProfileScope KAUF_PROFILE_NAME_(__LINE__)(::esphome::light::site)
+/// Profile one expression into site, the value passes through.
+#define KAUF_PROFILE_CALL(site, ...) \
+  ([&]() -> decltype(auto) { \
+    ::esphome::light::ProfileScope kauf_profile_call_(::esphome::light::site); \
+    return __VA_ARGS__; \
+  }())
+#else
+#define KAUF_PROFILE_SCOPE(site)
+#define KAUF_PROFILE_CALL(site, ...) (__VA_ARGS__)
+#endif
+
+}  // namespace esphome::light
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace esphome::light {
+
+/** KAUF: hands a value from one writer to one reader that may run outside the writer's context (a timer, the
+ * other core) without locking either of them.
+ *
+ * Two slots and a sequence number.  The writer fills the slot the sequence doesn't point at (edit()) and then
+ * publishes it by bumping the sequence.  The reader copies the slot the sequence points at and keeps the copy
+ * only if no publish happened meanwhile, since only after a publish can the writer start on the slot it was
+ * copying.  A write in progress never disturbs the reader, only a completed publish makes it copy again.
+ */
+template<typename T> class RenderBuffer {
+  static_assert(std::is_trivially_copyable<T>::value, "RenderBuffer copies its slots as plain memory");
+
+ public:
+  /// Writer: the slot to fill for the next publish().  Not read until then.
+  T &edit() {
+    // the publish before must be visible before this slot, the reader's last one, is written again
+    std::atomic_thread_fence(std::memory_order_release);
+    return this->slots_[(this->seq_.load(std::memory_order_relaxed) + 1) & 1];
+  }
+
+  /// Writer: make the slot from edit() the current one.
+  void publish() { this->seq_.store(this->seq_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  /// Reader: copy the current slot into out.  Returns false if the writer kept publishing during every attempt,
+  /// out then holds nothing useful.
+  bool read(T &out) const {
+    for (uint8_t attempt = 0; attempt < 4; attempt++) {
+      const uint32_t seq = this->seq_.load(std::memory_order_acquire);
+      out = this->slots_[seq & 1];
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (this->seq_.load(std::memory_order_relaxed) == seq)
+        return true;
+    }
+    return false;
+  }
+
+  /// Number of publishes so far.
+  uint32_t get_sequence() const { return this->seq_.load(std::memory_order_acquire); }
+
+ protected:
+  T slots_[2]{};
+  std::atomic<uint32_t> seq_{0};
+};
+
+}  // namespace esphome::light
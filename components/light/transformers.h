@@ -54,12 +54,12 @@ class LightTransitionTransformer : public LightTransformer {
 
     // KAUF: if starting in RGB, clear white brightness and vice versa
     if ( this->start_values_.color_mode_ & ColorCapability::RGB) {
-      this->start_values_.white_ = 0.0f;
+      this->start_values_.white_ = 0;
       this->start_values_.color_temperature_ = this->target_values_.color_temperature_;
     } else {
-      this->start_values_.red_ = 0.0f;
-      this->start_values_.green_ = 0.0f;
-      this->start_values_.blue_ = 0.0f;
+      this->start_values_.red_ = 0;
+      this->start_values_.green_ = 0;
+      this->start_values_.blue_ = 0;
     }
 
 
@@ -74,12 +74,12 @@ class LightTransitionTransformer : public LightTransformer {
 
     // KAUF: if ending in RGB, clear white brightness and vice versa
     if ( this->end_values_.color_mode_ & ColorCapability::RGB) {
-      this->end_values_.white_ = 0.0f;
+      this->end_values_.white_ = 0;
       this->end_values_.color_temperature_ = this->start_values_.color_temperature_;
     } else {
-      this->end_values_.red_ = 0.0f;
-      this->end_values_.green_ = 0.0f;
-      this->end_values_.blue_ = 0.0f;
+      this->end_values_.red_ = 0;
+      this->end_values_.green_ = 0;
+      this->end_values_.blue_ = 0;
     }
 
     // Get starting and ending RGB/WB/CT endpoints.
@@ -110,9 +110,20 @@ class LightTransitionTransformer : public LightTransformer {
 
   }
 
-  optional<LightColorValues> apply() override {
-    float p = this->get_progress_();
+  optional<LightColorValues> apply() override { return this->values_at_(this->get_progress_()); }
+
+  /// KAUF: the values at progress (0 to 1) without looking at the clock, for effect fades (LightEffectFade).
+  LightColorValues values_at(float progress) { return this->values_at_(progress); }
 
+#ifdef KAUF_TIMED_TRANSITIONS
+  bool sample(float progress, LightColorValues &values) override {
+    values = this->values_at_(progress);
+    return true;
+  }
+#endif
+
+ protected:
+  LightColorValues values_at_(float p) {
     // RGB variables and CT in mireds.
     float red, green, blue, ct_i, wb;
 
@@ -129,12 +140,13 @@ class LightTransitionTransformer : public LightTransformer {
 
     LightColorValues kauf_display;
     kauf_display.color_mode_ = this->end_values_.color_mode_;
-    kauf_display.state_ = ((this->end_values_.state_ - this->start_values_.state_) * p) + this->start_values_.state_;
-    kauf_display.red_ = red;
-    kauf_display.green_ = green;
-    kauf_display.blue_ = blue;
-    kauf_display.color_temperature_ = ct_i;
-    kauf_display.brightness_ = wb;
+    const float start_state = this->start_values_.get_state();
+    kauf_display.state_ = LightColorValues::to_unit_(((this->end_values_.get_state() - start_state) * p) + start_state);
+    kauf_display.red_ = LightColorValues::to_unit_(red);
+    kauf_display.green_ = LightColorValues::to_unit_(green);
+    kauf_display.blue_ = LightColorValues::to_unit_(blue);
+    kauf_display.color_temperature_ = LightColorValues::to_mired_(ct_i);
+    kauf_display.brightness_ = LightColorValues::to_unit_(wb);
 
 //    ESP_LOGD("KAUF Transformer","Return Values: P:%f R:%f  G:%f  B:%f  CT:%f  WB:%f", p, red, green, blue, ct_i, wb);
 
@@ -142,7 +154,6 @@ class LightTransitionTransformer : public LightTransformer {
 
   }
 
- protected:
   LightColorValues end_values_{};
   bool changing_color_mode_{false};
 };
@@ -205,4 +216,83 @@ class LightFlashTransformer : public LightTransformer {
   bool begun_lightstate_restore_;
 };
 
+#ifdef USE_LIGHT_RAMP
+/** KAUF: constant-rate brightness or color temperature ramp, started by light.ramp_start.
+ *
+ * Runs until finish() or until it reaches min/max.  remote_values are left alone while ramping, the final values
+ * are published and saved once in stop().  target_values_ always hold the linear values at the current ramp
+ * position, which is what LightState ends up with.
+ */
+class LightRampTransformer : public LightTransformer {
+ public:
+  LightRampTransformer(LightState &state, LightRampField field, float rate, float min, float max)
+      : state_(state), field_(field), rate_(rate), min_(min), max_(max) {}
+
+  void start() override {
+    this->start_value_ = this->field_ == LightRampField::BRIGHTNESS ? this->start_values_.get_brightness()
+                                                                     : this->start_values_.get_color_temperature();
+  }
+
+  optional<LightColorValues> apply() override {
+    float value = this->start_value_ + this->rate_ * ((millis() - this->start_time_) * (1.0f / 1000.0f));
+    if (value >= this->max_ && this->rate_ > 0.0f) {
+      value = this->max_;
+      this->finished_ = true;
+    } else if (value <= this->min_ && this->rate_ < 0.0f) {
+      value = this->min_;
+      this->finished_ = true;
+    }
+
+    LightColorValues &v = this->target_values_;
+    if (this->field_ == LightRampField::BRIGHTNESS) {
+      v.set_brightness(value);
+      v.set_state(value > 0.0f);
+    } else {
+      v.set_color_temperature(value);
+    }
+
+    // same output space as LightTransitionTransformer: steady gamma, then reverse Tasmota for write_state()
+    LightColorValues display;
+    float red = 0.0f, green = 0.0f, blue = 0.0f, white_brightness = 0.0f;
+    if (v.get_color_mode() & ColorCapability::RGB) {
+      v.as_rgb(&red, &green, &blue);
+    } else {
+      white_brightness = v.get_white_brightness();
+    }
+    display.set_color_mode(v.get_color_mode());
+    display.set_state(v.get_state());
+    display.set_red(to_transition_space_(red));
+    display.set_green(to_transition_space_(green));
+    display.set_blue(to_transition_space_(blue));
+    display.set_brightness(to_transition_space_(white_brightness));
+    display.set_color_temperature(v.get_color_temperature());
+    return display;
+  }
+
+  bool is_finished() override { return this->finished_; }
+
+  void finish() override { this->finished_ = true; }
+
+  // the ramp only ever touched current_values, commit where it stopped
+  void stop() override {
+    this->state_.remote_values = this->target_values_;
+    this->state_.publish_state();
+    this->state_.save_remote_values_();
+  }
+
+ protected:
+  static float to_transition_space_(float x) {
+    return LightTransitionTransformer::reverse_tasmota_gamma_(LightTransitionTransformer::gamma_default_(x));
+  }
+
+  LightState &state_;
+  LightRampField field_;
+  float rate_;  // per second
+  float min_;
+  float max_;
+  float start_value_{0.0f};
+  bool finished_{false};
+};
+#endif
+
 }  // namespace esphome::light
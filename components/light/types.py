@@ -30,6 +30,13 @@ COLOR_MODES = {
     "RGB_COLD_WARM_WHITE": ColorMode.RGB_COLD_WARM_WHITE,
 }
 
+# Ramp fields
+LightRampField = light_ns.enum("LightRampField", is_class=True)
+RAMP_FIELDS = {
+    "BRIGHTNESS": LightRampField.BRIGHTNESS,
+    "COLOR_TEMPERATURE": LightRampField.COLOR_TEMPERATURE,
+}
+
 # Limit modes
 LimitMode = light_ns.enum("LimitMode", is_class=True)
 LIMIT_MODES = {
@@ -40,8 +47,16 @@ LIMIT_MODES = {
 # Actions
 ToggleAction = light_ns.class_("ToggleAction", automation.Action)
 LightControlAction = light_ns.class_("LightControlAction", automation.Action)
+ConstantLightControlAction = light_ns.class_(
+    "ConstantLightControlAction", automation.Action
+)
 LightEffectCycleAction = light_ns.class_("LightEffectCycleAction", automation.Action)
 DimRelativeAction = light_ns.class_("DimRelativeAction", automation.Action)
+RampStartAction = light_ns.class_("RampStartAction", automation.Action)
+RampStopAction = light_ns.class_("RampStopAction", automation.Action)
+SceneStoreAction = light_ns.class_("SceneStoreAction", automation.Action)
+SceneRecallAction = light_ns.class_("SceneRecallAction", automation.Action)
+ProfileDumpAction = light_ns.class_("ProfileDumpAction", automation.Action)
 AddressableSet = light_ns.class_("AddressableSet", automation.Action)
 LightIsOnCondition = light_ns.class_("LightIsOnCondition", automation.Condition)
 LightIsOffCondition = light_ns.class_("LightIsOffCondition", automation.Condition)
@@ -64,6 +79,13 @@ AutomationLightEffect = light_ns.class_("AutomationLightEffect", LightEffect)
 StrobeLightEffect = light_ns.class_("StrobeLightEffect", LightEffect)
 StrobeLightEffectColor = light_ns.class_("StrobeLightEffectColor", LightEffect)
 FlickerLightEffect = light_ns.class_("FlickerLightEffect", LightEffect)
+TimelineLightEffect = light_ns.class_("TimelineLightEffect", LightEffect)
+TimelineMode = light_ns.enum("TimelineMode")
+TIMELINE_MODES = {
+    "ONCE": TimelineMode.TIMELINE_ONCE,
+    "LOOP": TimelineMode.TIMELINE_LOOP,
+    "PING_PONG": TimelineMode.TIMELINE_PING_PONG,
+}
 AddressableLightEffect = light_ns.class_("AddressableLightEffect", LightEffect)
 AddressableLambdaLightEffect = light_ns.class_(
     "AddressableLambdaLightEffect", AddressableLightEffect
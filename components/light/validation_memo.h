@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include "light_color_values.h"
+
+namespace esphome::light {
+
+/// KAUF: what a LightCall's validation depends on besides its own fields.
+struct ValidationInput {
+  LightColorValues remote_values;
+  uint32_t effect{0};
+  uint32_t default_transition{0};
+
+  // cheapest first
+  bool operator==(const ValidationInput &rhs) const {
+    return this->effect == rhs.effect && this->default_transition == rhs.default_transition &&
+           this->remote_values == rhs.remote_values;
+  }
+};
+
+/** KAUF: the last validation result of a constant call, with the input it was validated against.
+ *
+ * Used by ConstantLightCall.  Only builds on LightColorValues, so tests/validation_memo_test.cpp measures it on the
+ * host.
+ */
+template<typename Result> class ValidationMemo {
+ public:
+  template<typename... Args> explicit ValidationMemo(Args &&...args) : result_(std::forward<Args>(args)...) {}
+
+  /// The result for input: the last one if input is unchanged (reused is set), else from validate(Result &).
+  template<typename Validate> const Result &get(const ValidationInput &input, Validate &&validate, bool &reused) {
+    reused = this->valid_ && this->input_ == input;
+    if (!reused) {
+      this->input_ = input;
+      validate(this->result_);
+      this->valid_ = true;
+    }
+    return this->result_;
+  }
+
+ protected:
+  ValidationInput input_;
+  Result result_;
+  bool valid_{false};
+};
+
+}  // namespace esphome::light
@@ -0,0 +1,153 @@
+// LightColorValues against the float arithmetic it stands for.  Built twice: plain (float storage) and with
+// USE_LIGHT_COMPACT_VALUES (uint16 storage).  Each operation is checked against the same expression evaluated in
+// double from the float getters, which is what the float storage computes, and its worst error is printed and held
+// to a bound in units of the storage step (1/65535, color temperature 1/32 mired).
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+#include "light_color_values.h"
+
+using esphome::light::ColorMode;
+using esphome::light::LightColorValues;
+
+namespace {
+
+#ifdef USE_LIGHT_COMPACT_VALUES
+const char *const STORAGE = "uint16";
+const double UNIT_STEP = 1.0 / 65535.0;
+const double MIRED_STEP = 1.0 / 32.0;
+#else
+const char *const STORAGE = "float";
+const double UNIT_STEP = 1e-7;
+const double MIRED_STEP = 1e-4;
+#endif
+
+const uint32_t SAMPLES = 200000;
+
+uint32_t rng_state = 12345;
+uint32_t next_random() {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+// mostly in range, with exact ends and some out of range values to exercise clamping
+float random_unit() {
+  const uint32_t r = next_random();
+  switch (r % 16) {
+    case 0:
+      return 0.0f;
+    case 1:
+      return 1.0f;
+    case 2:
+      return -0.25f + (r >> 8) * (1.5f / 16777216.0f);
+    default:
+      return (r >> 8) * (1.0f / 16777216.0f);
+  }
+}
+
+float random_mireds() { return 153.0f + (next_random() >> 8) * (347.0f / 16777216.0f); }
+
+LightColorValues random_values(ColorMode mode) {
+  return LightColorValues(mode, random_unit(), random_unit(), random_unit(), random_unit(), random_unit(),
+                          random_unit(), random_unit(), random_mireds(), random_unit(), random_unit());
+}
+
+double clamp_unit(float x) { return x < 0.0f ? 0.0 : (x > 1.0f ? 1.0 : x); }
+
+struct Check {
+  const char *name;
+  double bound;  // in steps
+  double worst{0.0};
+
+  void add(double got, double want, double step) {
+    const double err = std::fabs(got - want) / step;
+    if (err > this->worst)
+      this->worst = err;
+  }
+  bool report() const {
+    // the float getters round too, a little past the bound is still in it
+    const bool ok = this->worst <= this->bound + 0.01;
+    std::printf("  %-22s worst %8.3f steps (bound %5.1f)%s\n", this->name, this->worst, this->bound, ok ? "" : "  FAIL");
+    return ok;
+  }
+};
+
+}  // namespace
+
+int main() {
+  Check roundtrip{"set/get unit", 0.5};
+  Check mireds{"set/get mireds", 0.5};
+  Check brightness{"as_brightness", 2.0};
+  Check rgb{"as_rgb", 3.0};
+  Check white{"get_white_brightness", 2.0};
+  Check cwww{"as_cwww", 3.0};
+  Check lerp{"lerp unit", 2.0};
+  Check lerp_mireds{"lerp mireds", 2.0};
+  Check normalize{"normalize_color", 1.0};
+
+  for (uint32_t i = 0; i < SAMPLES; i++) {
+    const float in = random_unit();
+    LightColorValues v;
+    v.set_red(in);
+    roundtrip.add(v.get_red(), clamp_unit(in), UNIT_STEP);
+    const float ct = random_mireds();
+    v.set_color_temperature(ct);
+    mireds.add(v.get_color_temperature(), ct, MIRED_STEP);
+
+    const LightColorValues a = random_values(ColorMode::RGB_COLD_WARM_WHITE);
+    const double level = double(a.get_state()) * a.get_brightness();
+
+    float out, r, g, b, cw, ww;
+    a.as_brightness(&out);
+    brightness.add(out, level, UNIT_STEP);
+
+    a.as_rgb(&r, &g, &b);
+    const double color = level * a.get_color_brightness();
+    rgb.add(r, color * a.get_red(), UNIT_STEP);
+    rgb.add(g, color * a.get_green(), UNIT_STEP);
+    rgb.add(b, color * a.get_blue(), UNIT_STEP);
+
+    white.add(a.get_white_brightness(), level * a.get_white(), UNIT_STEP);
+
+    a.as_cwww(&cw, &ww);
+    cwww.add(cw, level * a.get_cold_white(), UNIT_STEP);
+    cwww.add(ww, level * a.get_warm_white(), UNIT_STEP);
+
+    const LightColorValues c = random_values(ColorMode::RGB_COLD_WARM_WHITE);
+    const float t = (next_random() >> 8) * (1.0f / 16777216.0f);
+    const LightColorValues m = LightColorValues::lerp(a, c, t);
+    auto lerp_of = [t](double from, double to) { return from + t * (to - from); };
+    lerp.add(m.get_state(), lerp_of(a.get_state(), c.get_state()), UNIT_STEP);
+    lerp.add(m.get_brightness(), lerp_of(a.get_brightness(), c.get_brightness()), UNIT_STEP);
+    lerp.add(m.get_color_brightness(), lerp_of(a.get_color_brightness(), c.get_color_brightness()), UNIT_STEP);
+    lerp.add(m.get_red(), lerp_of(a.get_red(), c.get_red()), UNIT_STEP);
+    lerp.add(m.get_green(), lerp_of(a.get_green(), c.get_green()), UNIT_STEP);
+    lerp.add(m.get_blue(), lerp_of(a.get_blue(), c.get_blue()), UNIT_STEP);
+    lerp.add(m.get_white(), lerp_of(a.get_white(), c.get_white()), UNIT_STEP);
+    lerp.add(m.get_cold_white(), lerp_of(a.get_cold_white(), c.get_cold_white()), UNIT_STEP);
+    lerp.add(m.get_warm_white(), lerp_of(a.get_warm_white(), c.get_warm_white()), UNIT_STEP);
+    lerp_mireds.add(m.get_color_temperature(), lerp_of(a.get_color_temperature(), c.get_color_temperature()),
+                    MIRED_STEP);
+
+    LightColorValues n = random_values(ColorMode::RGB);
+    const double max = std::fmax(n.get_red(), std::fmax(n.get_green(), n.get_blue()));
+    const double want_r = max == 0.0 ? 1.0 : n.get_red() / max;
+    const double want_g = max == 0.0 ? 1.0 : n.get_green() / max;
+    const double want_b = max == 0.0 ? 1.0 : n.get_blue() / max;
+    n.normalize_color();
+    normalize.add(n.get_red(), want_r, UNIT_STEP);
+    normalize.add(n.get_green(), want_g, UNIT_STEP);
+    normalize.add(n.get_blue(), want_b, UNIT_STEP);
+  }
+
+  std::printf("LightColorValues with %s storage, %u bytes, %u samples:\n", STORAGE,
+              (unsigned) sizeof(LightColorValues), (unsigned) SAMPLES);
+  bool ok = true;
+  for (const Check *check : {&roundtrip, &mireds, &brightness, &rgb, &white, &cwww, &lerp, &lerp_mireds, &normalize})
+    ok = check->report() && ok;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+// Two simulated bulbs running clock synced random and pulse effects, booted 12.3 s apart so their millis() differ.
+// Each bulb keeps the effects' own state (fade start in local millis, last period) and steps it per frame the way
+// RandomLightEffect::apply() and PulseLightEffect::apply() do with clock sync, taking period, offset and random
+// values from effect_sync.h.  Once the late bulb has seen a whole period, both have to write identical frames.
+//
+// Only effect_sync.h is the real code here.  The effects need a LightState, so their apply() logic is copied below
+// (Bulb::random_frame(), Bulb::pulse_frame()) and has to be kept in step with light_effect.cpp by hand.
+
+#include <cstdint>
+#include <cstdio>
+
+#include "effect_sync.h"
+
+using esphome::light::effect_sync_period;
+using esphome::light::effect_sync_random;
+
+namespace {
+
+const uint64_t WALL_START_MS = 1760000000000ULL;  // some day in 2025, the wall clock every bulb gets from SNTP
+const uint32_t FRAME_MS = 16;                      // DIRECT_EFFECT_FRAME_INTERVAL
+const uint32_t RANDOM_INTERVAL_MS = 2000;
+const uint32_t RANDOM_TRANSITION_MS = 1500;
+const uint32_t PULSE_INTERVAL_MS = 1000;
+const uint32_t PULSE_TRANSITION_MS = 700;
+const uint32_t SEED = 0xC0FFEE;
+
+struct Rgb {
+  float r, g, b;
+  bool operator==(const Rgb &o) const { return r == o.r && g == o.g && b == o.b; }
+};
+
+// LightEffectFade, on millis() like the effects
+struct Fade {
+  Rgb from{0.0f, 0.0f, 0.0f}, to{0.0f, 0.0f, 0.0f};
+  uint32_t start{0}, length{0};
+  bool active{false};
+
+  Rgb at(uint32_t now) const {
+    const uint32_t elapsed = now - this->start;
+    if (elapsed >= this->length)
+      return this->to;
+    const float t = elapsed / float(this->length);
+    return {this->from.r + t * (this->to.r - this->from.r), this->from.g + t * (this->to.g - this->from.g),
+            this->from.b + t * (this->to.b - this->from.b)};
+  }
+};
+
+struct Bulb {
+  Bulb(uint64_t boot_wall_ms, uint32_t seed) : boot_wall_ms(boot_wall_ms), seed(seed) {}
+
+  uint64_t boot_wall_ms;  // millis() is 0 here
+  uint32_t seed;
+  Rgb current{0.0f, 0.0f, 0.0f};
+  Fade fade{};
+  uint32_t period_{0};
+
+  uint32_t millis(uint64_t wall) const { return static_cast<uint32_t>(wall - this->boot_wall_ms); }
+
+  // RandomLightEffect::apply() with clock sync
+  Rgb random_frame(uint64_t wall) {
+    const uint32_t now = this->millis(wall);
+    uint32_t period, offset;
+    effect_sync_period(wall, RANDOM_INTERVAL_MS, period, offset);
+    if (!this->fade.active || period != this->period_) {
+      this->period_ = period;
+      const Rgb target{effect_sync_random(this->seed, period, 0), effect_sync_random(this->seed, period, 1),
+                       effect_sync_random(this->seed, period, 2)};
+      this->fade = Fade{this->current, target, now - offset, RANDOM_TRANSITION_MS, true};
+    }
+    this->current = this->fade.at(now);
+    return this->current;
+  }
+
+  // PulseLightEffect::apply() with clock sync, brightness only
+  float pulse_frame(uint64_t wall) {
+    const uint32_t now = this->millis(wall);
+    uint32_t period, offset;
+    effect_sync_period(wall, PULSE_INTERVAL_MS, period, offset);
+    if (!this->fade.active || period != this->period_) {
+      this->period_ = period;
+      const bool on = period & 1;
+      const float level = on ? 1.0f : 0.0f;
+      this->fade = Fade{this->current, {level, level, level}, now - offset,
+                        on ? PULSE_TRANSITION_MS : PULSE_TRANSITION_MS / 2, true};
+    }
+    this->current = this->fade.at(now);
+    return this->current.r;
+  }
+};
+
+int failures = 0;
+
+void check(bool ok, const char *what) {
+  std::printf("  %-58s %s\n", what, ok ? "ok" : "FAIL");
+  if (!ok)
+    failures++;
+}
+
+// frames of both bulbs on the same wall clock instants, counted only once the late bulb saw a whole period
+template<typename Frame> uint32_t mismatches(Bulb &a, Bulb &b, uint32_t interval, Frame frame, uint32_t &compared) {
+  const uint64_t late_start = b.boot_wall_ms + 3;
+  const uint64_t compare_from = (late_start / interval + 1) * interval;
+  uint32_t wrong = 0;
+  compared = 0;
+  for (uint64_t wall = a.boot_wall_ms + 5; wall < late_start + 60000; wall += FRAME_MS) {
+    const auto va = frame(a, wall);
+    if (wall < late_start)
+      continue;
+    const auto vb = frame(b, wall);
+    if (wall < compare_from)
+      continue;
+    compared++;
+    if (!(va == vb))
+      wrong++;
+  }
+  return wrong;
+}
+
+}  // namespace
+
+int main() {
+  std::printf("clock synced effects, two bulbs booted 12.3 s apart:\n");
+
+  // the random sequence itself
+  bool in_range = true, repeatable = true;
+  for (uint32_t period = 0; period < 100000; period++) {
+    for (uint8_t n = 0; n < 7; n++) {
+      const float x = effect_sync_random(SEED, period, n);
+      in_range &= x >= 0.0f && x < 1.0f;
+      repeatable &= x == effect_sync_random(SEED, period, n);
+    }
+  }
+  check(in_range, "effect_sync_random() in [0, 1)");
+  check(repeatable, "effect_sync_random() depends on seed, period and n only");
+  check(effect_sync_random(SEED, 42, 0) != effect_sync_random(SEED + 1, 42, 0), "another seed, another sequence");
+
+  uint32_t period, offset;
+  effect_sync_period(WALL_START_MS + 12345, 1000, period, offset);
+  check(period == (WALL_START_MS + 12345) / 1000 && offset == 345, "effect_sync_period() splits the wall clock");
+
+  uint32_t compared;
+  {
+    Bulb a{WALL_START_MS, SEED}, b{WALL_START_MS + 12300, SEED};
+    const uint32_t wrong = mismatches(a, b, RANDOM_INTERVAL_MS, [](Bulb &bulb, uint64_t wall) {
+      return bulb.random_frame(wall);
+    }, compared);
+    std::printf("  random: %u of %u frames differ\n", (unsigned) wrong, (unsigned) compared);
+    check(compared > 3000 && wrong == 0, "random effect frames identical on both bulbs");
+  }
+  {
+    Bulb a{WALL_START_MS, SEED}, b{WALL_START_MS + 12300, SEED};
+    const uint32_t wrong = mismatches(a, b, PULSE_INTERVAL_MS, [](Bulb &bulb, uint64_t wall) {
+      return bulb.pulse_frame(wall);
+    }, compared);
+    std::printf("  pulse: %u of %u frames differ\n", (unsigned) wrong, (unsigned) compared);
+    check(compared > 3000 && wrong == 0, "pulse effect frames identical on both bulbs");
+  }
+  {
+    Bulb a{WALL_START_MS, SEED}, b{WALL_START_MS + 12300, SEED + 1};
+    const uint32_t wrong = mismatches(a, b, RANDOM_INTERVAL_MS, [](Bulb &bulb, uint64_t wall) {
+      return bulb.random_frame(wall);
+    }, compared);
+    check(wrong > compared / 2, "random effect frames differ with another seed");
+  }
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+// Driver for test_json_command.py: runs parse_json_command() + apply_json_command() from json_command.h against a
+// LightCall stand-in that records every setter call.
+//
+//   json_command_test            one hex encoded JSON text per stdin line, prints "reject" or "ok" and the calls
+//   json_command_test --bench N  N commands of the usual Home Assistant shapes, prints the throughput
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "json_command.h"
+
+using esphome::light::JsonCommand;
+using esphome::light::apply_json_command;
+using esphome::light::parse_json_command;
+
+namespace {
+
+// toggles are against a light that is on, test_json_command.py assumes the same
+const bool IS_ON = true;
+
+struct RecordingCall {
+  std::string calls;
+
+  void add(const char *name, const char *fmt, ...) __attribute__((format(printf, 3, 4))) {
+    char buf[64];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    this->calls += ' ';
+    this->calls += name;
+    this->calls += '=';
+    this->calls += buf;
+  }
+  // floats by their bits, so the comparison is exact
+  void add_float(const char *name, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    this->add(name, "%08x", (unsigned) bits);
+  }
+
+  void set_state(bool state) { this->add("state", "%d", state ? 1 : 0); }
+  void set_brightness(float v) { this->add_float("brightness", v); }
+  void set_red(float v) { this->add_float("red", v); }
+  void set_green(float v) { this->add_float("green", v); }
+  void set_blue(float v) { this->add_float("blue", v); }
+  void set_color_brightness(float v) { this->add_float("color_brightness", v); }
+  void set_cold_white(float v) { this->add_float("cold_white", v); }
+  void set_warm_white(float v) { this->add_float("warm_white", v); }
+  void set_white(float v) { this->add_float("white", v); }
+  void set_color_temperature(float v) { this->add_float("color_temperature", v); }
+  void set_flash_length(uint32_t v) { this->add("flash_length", "%u", (unsigned) v); }
+  void set_transition_length(uint32_t v) { this->add("transition_length", "%u", (unsigned) v); }
+  void set_effect(uint32_t v) { this->add("effect_index", "%u", (unsigned) v); }
+  void set_effect(const char *str, size_t len) {
+    std::string hex;
+    for (size_t i = 0; i < len; i++) {
+      char byte[3];
+      snprintf(byte, sizeof(byte), "%02x", (unsigned) (uint8_t) str[i]);
+      hex += byte;
+    }
+    this->add("effect", "%s", hex.c_str());
+  }
+};
+
+// the same count for the calls, without the string building
+struct CountingCall {
+  uint32_t calls{0};
+  void set_state(bool) { this->calls++; }
+  void set_brightness(float) { this->calls++; }
+  void set_red(float) { this->calls++; }
+  void set_green(float) { this->calls++; }
+  void set_blue(float) { this->calls++; }
+  void set_color_brightness(float) { this->calls++; }
+  void set_cold_white(float) { this->calls++; }
+  void set_warm_white(float) { this->calls++; }
+  void set_white(float) { this->calls++; }
+  void set_color_temperature(float) { this->calls++; }
+  void set_flash_length(uint32_t) { this->calls++; }
+  void set_transition_length(uint32_t) { this->calls++; }
+  void set_effect(uint32_t) { this->calls++; }
+  void set_effect(const char *, size_t) { this->calls++; }
+};
+
+int hex_value(char c) {
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  return -1;
+}
+
+int run_lines() {
+  std::string line;
+  while (std::getline(std::cin, line)) {
+    std::string text;
+    for (size_t i = 0; i + 1 < line.size(); i += 2)
+      text += char(hex_value(line[i]) * 16 + hex_value(line[i + 1]));
+
+    JsonCommand cmd;
+    if (!parse_json_command(text.data(), text.size(), cmd)) {
+      std::printf("reject\n");
+      continue;
+    }
+    RecordingCall call;
+    apply_json_command(cmd, call, IS_ON);
+    std::printf("ok%s\n", call.calls.c_str());
+  }
+  return 0;
+}
+
+int run_bench(uint32_t count) {
+  static const char *const COMMANDS[] = {
+      R"({"state":"ON","brightness":128})",
+      R"({"state":"ON","color":{"r":255,"g":80,"b":0},"transition":2})",
+      R"({"state":"ON","color_temp":370,"brightness":255})",
+      R"({"state":"OFF","transition":1})",
+      R"({"state":"ON","effect":"Random"})",
+      R"({"state": "ON", "brightness": 60, "color": {"r": 12, "g": 34, "b": 56}, "transition": 0})",
+  };
+  constexpr uint32_t kinds = sizeof(COMMANDS) / sizeof(COMMANDS[0]);
+  size_t lengths[kinds];
+  size_t bytes = 0;
+  for (uint32_t i = 0; i < kinds; i++)
+    lengths[i] = strlen(COMMANDS[i]);
+
+  CountingCall call;
+  uint32_t rejected = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < count; i++) {
+    const uint32_t k = i % kinds;
+    JsonCommand cmd;
+    if (!parse_json_command(COMMANDS[k], lengths[k], cmd)) {
+      rejected++;
+      continue;
+    }
+    apply_json_command(cmd, call, IS_ON);
+    bytes += lengths[k];
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::printf("%u commands in %.3f s: %.0f commands/s, %.1f MB/s, %u setter calls, %u rejected\n", (unsigned) count,
+              seconds, count / seconds, bytes / seconds / 1e6, (unsigned) call.calls, (unsigned) rejected);
+  return rejected == 0 ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  if (argc == 3 && strcmp(argv[1], "--bench") == 0)
+    return run_bench(uint32_t(strtoul(argv[2], nullptr, 10)));
+  return run_lines();
+}
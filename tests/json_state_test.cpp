@@ -0,0 +1,298 @@
+// JsonState encoder and JsonStateCache from json_state.h.
+//
+// The encoder is checked against a model of what ArduinoJson serializes for LightJSONSchema::dump_json(): an
+// ordered object where setting a key again overwrites it in place.  The cache is checked to fill once per
+// generation however many readers ask, and then timed with three readers per change (web_server SSE, REST, MQTT)
+// against every reader working the state out itself.  The fill below copies fill_json_state() from
+// light_json_schema.cpp, which needs a LightState, and has to be kept in step with it by hand.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "json_state.h"
+#include "light_color_values.h"
+
+using esphome::light::ColorCapability;
+using esphome::light::ColorMode;
+using esphome::light::encode_json_state;
+using esphome::light::JsonState;
+using esphome::light::JsonStateCache;
+using esphome::light::LightColorValues;
+using esphome::light::to_uint8_scale;
+
+namespace {
+
+const uint32_t SAMPLES = 100000;
+const uint32_t CHANGES = 200000;
+const uint32_t READERS = 3;
+
+int failures = 0;
+
+void check(bool ok, const char *what) {
+  std::printf("  %-62s %s\n", what, ok ? "ok" : "FAIL");
+  if (!ok)
+    failures++;
+}
+
+uint32_t rng_state = 2463534242u;
+uint32_t next_random() {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+// --- ArduinoJson model ----------------------------------------------------------------------------------------------
+
+std::string json_string(const char *str, size_t len) {
+  std::string out = "\"";
+  for (size_t i = 0; i < len; i++) {
+    const char c = str[i];
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<uint8_t>(c) < 0x20) {
+      char esc[7];
+      std::snprintf(esc, sizeof(esc), "\\u%04x", (unsigned) static_cast<uint8_t>(c));
+      out += esc;
+    } else {
+      out += c;
+    }
+  }
+  return out + "\"";
+}
+
+struct Object {
+  std::vector<std::pair<std::string, std::string>> members;
+
+  void set(const std::string &key, const std::string &value) {
+    for (auto &member : this->members) {
+      if (member.first == key) {
+        member.second = value;
+        return;
+      }
+    }
+    this->members.emplace_back(key, value);
+  }
+  void set(const std::string &key, uint32_t value) { this->set(key, std::to_string(value)); }
+
+  std::string str() const {
+    std::string out = "{";
+    for (const auto &member : this->members) {
+      if (out.size() > 1)
+        out += ',';
+      out += "\"" + member.first + "\":" + member.second;
+    }
+    return out + "}";
+  }
+};
+
+// LightJSONSchema::dump_json() into the model
+std::string model_json(const JsonState &s) {
+  Object root, color;
+  if (s.has(JsonState::HAS_EFFECTS)) {
+    root.set("effect", json_string(s.effect, s.effect_len));
+    root.set("effect_index", s.effect_index);
+    root.set("effect_count", s.effect_count);
+  }
+  if (s.color_mode != nullptr)
+    root.set("color_mode", json_string(s.color_mode, strlen(s.color_mode)));
+  if (s.has(JsonState::HAS_STATE))
+    root.set("state", s.has(JsonState::STATE_ON) ? "\"ON\"" : "\"OFF\"");
+  if (s.has(JsonState::HAS_BRIGHTNESS))
+    root.set("brightness", s.brightness);
+  root.set("color", "");  // position only, filled in below
+  color.set("r", s.red);
+  color.set("g", s.green);
+  color.set("b", s.blue);
+  if (s.has(JsonState::HAS_WHITE)) {
+    color.set("w", s.white);
+    root.set("white_value", s.white);
+  }
+  root.set("color_temp", s.color_temp);
+  if (s.has(JsonState::HAS_CWWW)) {
+    color.set("c", s.cold_white);
+    color.set("w", s.warm_white);
+  }
+  root.set("color", color.str());
+  return root.str();
+}
+
+const char *const EFFECTS[] = {"None", "Random", "Pulse", "Color Loop", "Say \"hi\"", "back\\slash", "tab\there",
+                               "K\xc3\xa4se", "\x01\x1f"};
+const char *const MODES[] = {"onoff", "brightness", "white", "color_temp", "cwww", "rgb", "rgbw", "rgbct", "rgbww"};
+
+JsonState random_state() {
+  JsonState s;
+  s.flags = uint8_t(next_random() & 0x3F);
+  const char *effect = EFFECTS[next_random() % (sizeof(EFFECTS) / sizeof(EFFECTS[0]))];
+  s.effect = effect;
+  s.effect_len = uint16_t(strlen(effect));
+  s.effect_index = next_random() % 12;
+  s.effect_count = next_random() % 12;
+  const uint32_t mode = next_random() % 10;
+  s.color_mode = mode == 9 ? nullptr : MODES[mode];
+  s.color_temp = next_random() % 3 == 0 ? next_random() : 153 + next_random() % 348;
+  s.brightness = uint8_t(next_random());
+  s.red = uint8_t(next_random());
+  s.green = uint8_t(next_random());
+  s.blue = uint8_t(next_random());
+  s.white = uint8_t(next_random());
+  s.cold_white = uint8_t(next_random());
+  s.warm_white = uint8_t(next_random());
+  return s;
+}
+
+// --- fill_json_state() stand-in -------------------------------------------------------------------------------------
+
+struct Light {
+  LightColorValues remote_values;
+  uint32_t generation{0};
+  uint32_t fills{0};
+};
+
+void fill_json_state(Light &light, JsonState &s) {
+  light.fills++;
+  s.flags |= JsonState::HAS_EFFECTS;
+  s.effect = EFFECTS[1];
+  s.effect_len = 6;
+  s.effect_index = 1;
+  s.effect_count = 11;
+
+  const auto &values = light.remote_values;
+  const auto color_mode = values.get_color_mode();
+  s.color_mode = MODES[8];
+  if (color_mode & ColorCapability::ON_OFF) {
+    s.flags |= JsonState::HAS_STATE;
+    if (values.get_state() != 0.0f)
+      s.flags |= JsonState::STATE_ON;
+  }
+  if (color_mode & ColorCapability::BRIGHTNESS) {
+    s.flags |= JsonState::HAS_BRIGHTNESS;
+    s.brightness = to_uint8_scale(values.get_brightness());
+  }
+  float color_brightness = values.get_color_brightness();
+  s.red = to_uint8_scale(color_brightness * values.get_red());
+  s.green = to_uint8_scale(color_brightness * values.get_green());
+  s.blue = to_uint8_scale(color_brightness * values.get_blue());
+  if (color_mode & ColorCapability::WHITE) {
+    s.flags |= JsonState::HAS_WHITE;
+    s.white = to_uint8_scale(values.get_white());
+  }
+  s.color_temp = uint32_t(values.get_color_temperature());
+  if (color_mode & ColorCapability::COLD_WARM_WHITE) {
+    s.flags |= JsonState::HAS_CWWW;
+    s.cold_white = to_uint8_scale(values.get_cold_white());
+    s.warm_white = to_uint8_scale(values.get_warm_white());
+  }
+}
+
+void change(Light &light, uint32_t i) {
+  light.remote_values.set_color_mode(i & 1 ? ColorMode::RGB : ColorMode::COLD_WARM_WHITE);
+  light.remote_values.set_brightness(float(i % 256) / 255.0f);
+  light.remote_values.set_red(float((i * 7) % 256) / 255.0f);
+  light.remote_values.set_color_temperature(153.0f + float(i % 347));
+  light.generation++;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+int main() {
+  std::printf("JsonState encoder and cache:\n");
+
+  uint32_t wrong = 0;
+  char buf[JsonStateCache::TEXT_SIZE];
+  for (uint32_t i = 0; i < SAMPLES; i++) {
+    const JsonState s = random_state();
+    const size_t len = encode_json_state(s, buf, sizeof(buf));
+    const std::string want = model_json(s);
+    if (len != want.size() || want != buf)
+      wrong++;
+  }
+  std::printf("  %u of %u random states differ from the ArduinoJson model\n", (unsigned) wrong, (unsigned) SAMPLES);
+  check(wrong == 0, "encode_json_state() matches dump_json() through ArduinoJson");
+
+  {
+    std::string long_name(300, 'x');
+    JsonState s = random_state();
+    s.flags |= JsonState::HAS_EFFECTS;
+    s.effect = long_name.c_str();
+    s.effect_len = uint16_t(long_name.size());
+    check(encode_json_state(s, buf, sizeof(buf)) == 0, "a state longer than the buffer encodes to 0");
+    JsonStateCache cache;
+    size_t len = 1;
+    check(cache.text(1, [&s](JsonState &out) { out = s; }, &len) == nullptr && len == 1,
+          "the cache hands out no text for it");
+  }
+
+  {
+    Light light;
+    JsonStateCache cache;
+    auto fill = [&light](JsonState &s) { fill_json_state(light, s); };
+    bool same = true;
+    for (uint32_t i = 0; i < 1000; i++) {
+      change(light, i);
+      JsonState fresh;
+      fill_json_state(light, fresh);
+      const std::string want = model_json(fresh);
+      for (uint32_t r = 0; r < READERS; r++) {
+        size_t len = 0;
+        const char *text = cache.text(light.generation, fill, &len);
+        same &= text != nullptr && want == text && len == want.size();
+        same &= model_json(cache.state(light.generation, fill)) == want;
+      }
+    }
+    // the fresh fill above counts too
+    check(light.fills == 2000, "one fill per generation for every reader, state and text");
+    check(same, "cached state and text follow the generation");
+  }
+
+  // readers per change: each works the state out (fill + encode), or all of them share the cache
+  Light light;
+  light.remote_values.set_state(1.0f);
+  light.remote_values.set_color_brightness(1.0f);
+  size_t sink = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < CHANGES; i++) {
+    change(light, i);
+    for (uint32_t r = 0; r < READERS; r++) {
+      JsonState s;
+      fill_json_state(light, s);
+      sink += encode_json_state(s, buf, sizeof(buf));
+    }
+  }
+  const double per_reader = seconds_since(start);
+
+  JsonStateCache cache;
+  auto fill = [&light](JsonState &s) { fill_json_state(light, s); };
+  light.fills = 0;
+  start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < CHANGES; i++) {
+    change(light, i);
+    for (uint32_t r = 0; r < READERS; r++) {
+      size_t len = 0;
+      cache.text(light.generation, fill, &len);
+      sink += len;
+    }
+  }
+  const double cached = seconds_since(start);
+
+  const double reads = double(CHANGES) * READERS;
+  std::printf("  %u changes, %u readers each (%zu bytes):\n", (unsigned) CHANGES, (unsigned) READERS, sink);
+  std::printf("    per reader: %8.0f ns per change, %10.0f reads/s\n", per_reader / CHANGES * 1e9, reads / per_reader);
+  std::printf("    cached:     %8.0f ns per change, %10.0f reads/s, %u fills\n", cached / CHANGES * 1e9,
+              reads / cached, (unsigned) light.fills);
+  check(light.fills == CHANGES, "cached: one fill per change");
+  check(cached < per_reader, "cached is faster than every reader encoding");
+
+  return failures == 0 ? 0 : 1;
+}
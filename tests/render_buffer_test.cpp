@@ -0,0 +1,75 @@
+// Torn-read stress test for RenderBuffer: one writer thread publishes as fast as it can while one reader thread
+// checks every snapshot it gets is a single publish, never a mix of two.
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+#include "render_state.h"
+
+using esphome::light::RenderBuffer;
+
+namespace {
+
+// about the size of the timed transition frames, big enough that a copy spans many writer stores
+struct Payload {
+  uint32_t words[85];
+};
+
+const uint32_t PUBLISHES = 2000000;
+
+}  // namespace
+
+int main() {
+  static RenderBuffer<Payload> buffer;
+  std::atomic<bool> done{false};
+
+  std::thread writer([&]() {
+    for (uint32_t n = 1; n <= PUBLISHES; n++) {
+      Payload &slot = buffer.edit();
+      for (auto &word : slot.words)
+        word = n;
+      buffer.publish();
+    }
+    done.store(true, std::memory_order_release);
+  });
+
+  uint32_t reads = 0;
+  uint32_t failed = 0;
+  uint32_t torn = 0;
+  uint32_t backwards = 0;
+  uint32_t last = 0;
+  Payload snapshot;
+  while (!done.load(std::memory_order_acquire) || reads == 0) {
+    if (!buffer.read(snapshot)) {
+      failed++;
+      continue;
+    }
+    reads++;
+    const uint32_t n = snapshot.words[0];
+    for (auto word : snapshot.words) {
+      if (word != n) {
+        torn++;
+        break;
+      }
+    }
+    if (n < last)
+      backwards++;
+    last = n;
+  }
+  writer.join();
+
+  std::printf("%u publishes, %u reads, %u gave up, %u torn, %u out of order\n", (unsigned) PUBLISHES,
+              (unsigned) reads, (unsigned) failed, (unsigned) torn, (unsigned) backwards);
+
+  if (buffer.get_sequence() != PUBLISHES) {
+    std::printf("FAIL: sequence %u after %u publishes\n", (unsigned) buffer.get_sequence(), (unsigned) PUBLISHES);
+    return 1;
+  }
+  if (torn != 0 || backwards != 0) {
+    std::printf("FAIL\n");
+    return 1;
+  }
+  return 0;
+}
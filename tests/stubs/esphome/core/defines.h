@@ -0,0 +1,2 @@
+#pragma once
+// Host build stub: the tests set the USE_* / KAUF_* defines they need on the command line.
@@ -0,0 +1,32 @@
+#pragma once
+// Host build stub: the parts of ESPHome's FiniteSetMask that color_mode.h and light_traits.h use.
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace esphome {
+
+template<typename ValueType, typename BitPolicy> class FiniteSetMask {
+ public:
+  using bitmask_t = typename BitPolicy::mask_t;
+
+  constexpr FiniteSetMask() = default;
+  constexpr FiniteSetMask(std::initializer_list<ValueType> values) {
+    for (const ValueType &value : values)
+      this->insert(value);
+  }
+
+  constexpr void insert(ValueType value) { this->mask_ |= bitmask_t(1) << BitPolicy::to_bit(value); }
+  constexpr size_t count(ValueType value) const { return (this->mask_ >> BitPolicy::to_bit(value)) & 1; }
+  constexpr size_t size() const { return __builtin_popcount(this->mask_); }
+  constexpr bitmask_t get_mask() const { return this->mask_; }
+
+  static constexpr bool mask_contains(bitmask_t mask, ValueType value) {
+    return (mask >> BitPolicy::to_bit(value)) & 1;
+  }
+
+ protected:
+  bitmask_t mask_{0};
+};
+
+}  // namespace esphome
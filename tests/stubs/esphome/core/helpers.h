@@ -0,0 +1,3 @@
+#pragma once
+// Host build stub: only the parts of ESPHome's helpers.h the tested headers use.
+#include <algorithm>
@@ -0,0 +1,130 @@
+"""Exhaustive checks of the reverse gamma tables against the forward table search they replace.
+
+Plain pytest, no ESPHome needed: pytest tests/test_gamma_tables.py
+"""
+
+from pathlib import Path
+import importlib.util
+
+import pytest
+
+# load the generator by path, importing it through the light package would pull in ESPHome
+_spec = importlib.util.spec_from_file_location(
+    "gamma_tables", Path(__file__).parent.parent / "components" / "light" / "gamma_tables.py"
+)
+gamma_tables = importlib.util.module_from_spec(_spec)
+_spec.loader.exec_module(gamma_tables)
+
+GAMMAS = [0.0, 1.0, 1.8, 2.2, 2.8, 3.0, 4.0]
+
+
+def search(fwd, target):
+    """gamma_table_reverse_search(): largest index with fwd[index] <= target."""
+    lo, hi = 0, 255
+    while lo < hi:
+        mid = (lo + hi + 1) // 2
+        if fwd[mid] <= target:
+            lo = mid
+        else:
+            hi = mid - 1
+    return lo
+
+
+def uncorrect8_search(fwd, value):
+    """ESPColorCorrection::gamma_uncorrect_() before the reverse table."""
+    if value == 0:
+        return 0
+    target = value * 257
+    lo = search(fwd, target)
+    if lo >= 255:
+        return 255
+    a, b = fwd[lo], fwd[lo + 1]
+    return lo if target - a <= b - target else lo + 1
+
+
+def uncorrect_search(fwd, value):
+    """LightState::gamma_uncorrect_lut() before the reverse table."""
+    if value <= 0.0:
+        return 0.0
+    if value >= 1.0:
+        return 1.0
+    target = int(value * 65535.0)
+    lo = search(fwd, target)
+    if lo >= 255:
+        return 1.0
+    a, b = fwd[lo], fwd[lo + 1]
+    if b == a:
+        return lo / 255.0
+    return (lo + (target - a) / (b - a)) / 255.0
+
+
+def uncorrect_table(fwd, rev, value):
+    """LightState::gamma_uncorrect_lut() with the reverse table."""
+    if value <= 0.0:
+        return 0.0
+    if value >= 1.0:
+        return 1.0
+    scaled = value * 255.0
+    idx = int(scaled)
+    if idx == 0:
+        return uncorrect_search(fwd, value)
+    if idx >= 255:
+        return rev[255] / 65535.0
+    frac = scaled - idx
+    return (rev[idx] + frac * (rev[idx + 1] - rev[idx])) / 65535.0
+
+
+def correct(fwd, value):
+    """LightState::gamma_correct_lut()."""
+    scaled = value * 255.0
+    idx = int(scaled)
+    if idx >= 255:
+        return fwd[255] / 65535.0
+    frac = scaled - idx
+    return (fwd[idx] + frac * (fwd[idx + 1] - fwd[idx])) / 65535.0
+
+
+@pytest.fixture(params=GAMMAS, ids=lambda g: f"gamma_{g}")
+def tables(request):
+    fwd = gamma_tables.gamma_table(request.param)
+    rev, rev8 = gamma_tables.gamma_reverse_tables(fwd)
+    return fwd, rev, rev8
+
+
+def test_table_shapes(tables):
+    fwd, rev, rev8 = tables
+    assert len(fwd) == len(rev) == len(rev8) == 256
+    assert all(0 <= x <= 65535 for x in fwd + rev)
+    assert all(0 <= x <= 255 for x in rev8)
+    assert fwd == sorted(fwd)
+    assert rev == sorted(rev)
+    assert rev8 == sorted(rev8)
+
+
+def test_uint8_matches_search(tables):
+    fwd, _, rev8 = tables
+    for value in range(256):
+        assert rev8[value] == uncorrect8_search(fwd, value), value
+
+
+def test_uint16_matches_search(tables):
+    # every uint16 input, the table interpolates where the search interpolated between forward entries
+    fwd, rev, _ = tables
+    worst = 0.0
+    for raw in range(65536):
+        value = raw / 65535.0
+        worst = max(worst, abs(uncorrect_table(fwd, rev, value) - uncorrect_search(fwd, value)))
+    # the table interpolates linearly across a whole corrected step, the search across a forward entry.
+    # Measured worst 0.78/255 at gamma 4, 0.57/255 at the default 2.8
+    assert worst <= 1.0 / 255.0, worst
+
+
+def test_round_trip(tables):
+    # correcting an uncorrected value gives it back, within the forward table's own interpolation
+    fwd, rev, _ = tables
+    worst = 0.0
+    for raw in range(65536):
+        value = raw / 65535.0
+        worst = max(worst, abs(correct(fwd, uncorrect_table(fwd, rev, value)) - value))
+    # measured worst 0.065/255 at gamma 4
+    assert worst <= 0.25 / 255.0, worst
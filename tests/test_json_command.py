@@ -0,0 +1,246 @@
+"""Fuzz of the single pass JSON command reader (components/light/json_command.h) against the ArduinoJson path.
+
+ArduinoJson isn't available on the host, so the ArduinoJson path is modeled here: Python's json module for the
+parsing, and LightJSONSchema::parse_color_json() + parse_json() with ArduinoJson's is<T>() rules for the calls.
+For every text the reader takes, its LightCall setter calls have to match the model exactly (floats by their bits).
+Texts that aren't valid JSON objects have to be turned down, so they go to ArduinoJson and fail the same way there.
+
+Run through ctest, which builds json_command_test and passes its path in JSON_COMMAND_TEST.
+"""
+
+import json
+import os
+import random
+import struct
+import subprocess
+
+import pytest
+
+BINARY = os.environ.get("JSON_COMMAND_TEST")
+pytestmark = pytest.mark.skipif(BINARY is None, reason="JSON_COMMAND_TEST not set, run through ctest")
+
+IS_ON = True  # json_command_test.cpp toggles against a light that is on
+UINT8, UINT16, UINT32 = 0xFF, 0xFFFF, 0xFFFFFFFF
+
+
+def f32(x):
+    return struct.unpack("<f", struct.pack("<f", x))[0]
+
+
+def bits(x):
+    return f"{struct.unpack('<I', struct.pack('<f', x))[0]:08x}"
+
+
+def is_uint(value, max_value):
+    """ArduinoJson is<uint8_t/uint16_t/uint32_t>()."""
+    return isinstance(value, int) and not isinstance(value, bool) and 0 <= value <= max_value
+
+
+def on_off(value):
+    """parse_on_off(), ASCII case insensitive."""
+    lower = "".join(chr(ord(c) + 32) if "A" <= c <= "Z" else c for c in value)
+    return {"on": True, "off": False, "toggle": not IS_ON}.get(lower)
+
+
+def length_ms(value):
+    """uint32_t(float(value) * 1000), None where the conversion overflows (undefined in C++)."""
+    ms = f32(f32(value) * 1000.0)
+    return int(ms) if ms < 2**32 else None
+
+
+def model_calls(root):
+    """LightJSONSchema::parse_color_json() + parse_json() on a parsed object, as the setter calls they make."""
+    calls = []
+    state = root.get("state")
+    if isinstance(state, str) and on_off(state) is not None:
+        calls.append(f"state={int(on_off(state))}")
+    if is_uint(root.get("brightness"), UINT8):
+        calls.append(f"brightness={bits(f32(root['brightness'] / 255.0))}")
+
+    color = root.get("color")
+    if isinstance(color, dict):
+        max_rgb = 0.0
+        for key, name in (("r", "red"), ("g", "green"), ("b", "blue")):
+            if is_uint(color.get(key), UINT8):
+                value = f32(color[key] / 255.0)
+                max_rgb = max(max_rgb, value)
+                calls.append(f"{name}={bits(value)}")
+        if any(is_uint(color.get(key), UINT8) for key in "rgb"):
+            calls.append(f"color_brightness={bits(max_rgb)}")
+        if is_uint(color.get("c"), UINT8):
+            calls.append(f"cold_white={bits(f32(color['c'] / 255.0))}")
+        if is_uint(color.get("w"), UINT8):
+            name = "warm_white" if is_uint(color.get("c"), UINT8) else "white"
+            calls.append(f"{name}={bits(f32(color['w'] / 255.0))}")
+
+    if is_uint(root.get("white_value"), UINT8):
+        calls.append(f"white={bits(f32(root['white_value'] / 255.0))}")
+    if is_uint(root.get("color_temp"), UINT16):
+        calls.append(f"color_temperature={bits(f32(root['color_temp']))}")
+    if is_uint(root.get("flash"), UINT32):
+        ms = length_ms(root["flash"])
+        if ms is None:
+            return None
+        calls.append(f"flash_length={ms}")
+    if is_uint(root.get("transition"), UINT16):
+        calls.append(f"transition_length={length_ms(root['transition'])}")
+    if isinstance(root.get("effect"), str):
+        calls.append(f"effect={root['effect'].encode().hex()}")
+    if is_uint(root.get("effect_index"), UINT32):
+        calls.append(f"effect_index={root['effect_index']}")
+    return " ".join(["ok"] + calls)
+
+
+def strict_object(text):
+    """The parsed object if text is one valid JSON object (no NaN/Infinity, no duplicate keys), else None."""
+
+    def no_duplicates(pairs):
+        keys = [k for k, _ in pairs]
+        if len(keys) != len(set(keys)):
+            raise ValueError("duplicate key")
+        return dict(pairs)
+
+    def no_constant(name):
+        raise ValueError(name)
+
+    try:
+        root = json.loads(text, object_pairs_hook=no_duplicates, parse_constant=no_constant)
+    except ValueError:
+        return None
+    return root if isinstance(root, dict) else None
+
+
+def run(texts):
+    lines = "".join(t.encode().hex() + "\n" for t in texts)
+    out = subprocess.run([BINARY], input=lines, capture_output=True, text=True, check=True).stdout
+    results = out.splitlines()
+    assert len(results) == len(texts)
+    return results
+
+
+# --- generators ---------------------------------------------------------------------------------------------------
+
+EFFECTS = ["None", "Random", "Pulse", "Strobe", "Color Loop", "Flicker", "Slow Pulse", "Käse", "🌈 Rainbow"]
+WS = ["", "", "", " ", "  ", "\n", "\t", "\r\n  "]
+
+
+def ws(rng):
+    return rng.choice(WS)
+
+
+def ha_command(rng):
+    """A command of the shapes Home Assistant's MQTT JSON light sends, all of which the reader has to take."""
+    members = {}
+    if rng.random() < 0.9:
+        members["state"] = rng.choice(["ON", "OFF", "on", "Off", "TOGGLE", "toggle", "maybe"])
+    if rng.random() < 0.5:
+        members["brightness"] = rng.randint(0, 300)
+    if rng.random() < 0.4:
+        color = {}
+        for key in rng.sample("rgbcw", rng.randint(0, 5)):
+            color[key] = rng.randint(0, 300)
+        members["color"] = color
+    if rng.random() < 0.3:
+        members["color_temp"] = rng.choice([153, 250, 370, 500, 65535, 65536, 100000])
+    if rng.random() < 0.1:
+        members["white_value"] = rng.randint(0, 300)
+    if rng.random() < 0.3:
+        members["transition"] = rng.choice([0, 1, 2, 10, 65535, 65536, 4000000])
+    elif rng.random() < 0.1:
+        members["flash"] = rng.choice([0, 1, 2, 10, 4000000])
+    if rng.random() < 0.2:
+        members["effect"] = rng.choice(EFFECTS)
+    if rng.random() < 0.1:
+        members["effect_index"] = rng.choice([0, 1, 5, 4294967295])
+    # wrong types for known keys are ignored by both paths
+    if rng.random() < 0.1:
+        members[rng.choice(["brightness", "effect", "color_temp"])] = rng.choice(["12", 7, "x"])
+
+    keys = list(members)
+    rng.shuffle(keys)
+
+    def encode(value):
+        if isinstance(value, dict):
+            inner = list(value.items())
+            return "{" + ws(rng) + ("," + ws(rng)).join(
+                f'"{k}"{ws(rng)}:{ws(rng)}{v}' for k, v in inner) + ws(rng) + "}"
+        return json.dumps(value, ensure_ascii=False)
+
+    body = ("," + ws(rng)).join(f'{ws(rng)}"{k}"{ws(rng)}:{ws(rng)}{encode(members[k])}' for k in keys)
+    return ws(rng) + "{" + body + ws(rng) + "}" + ws(rng)
+
+
+ODD_VALUES = ["-1", "-0", "1.0", "1e2", "0.5", "01", "true", "false", "null", "[]", "[1]", "{}", '"\\u004f\\u004e"',
+              '"O\\"N"', "99999999999", "4294967296", "NaN", "Infinity", '"ON', "1 2", ""]
+ODD_MEMBERS = ['"unknown":1', '"Brightness":5', '"state":"ON"', '"color":{"x":1}', '"color":{"r":1,"r":2}',
+               '"color":[1,2,3]', '"effect":"a\\nb"']
+
+
+def odd_command(rng):
+    """A command with something only ArduinoJson handles, or that is invalid."""
+    text = ha_command(rng)
+    choice = rng.random()
+    if choice < 0.4:
+        key = rng.choice(["brightness", "state", "transition", "flash", "color_temp", "effect", "effect_index"])
+        member = f'"{key}":{rng.choice(ODD_VALUES)}'
+    elif choice < 0.7:
+        member = rng.choice(ODD_MEMBERS)
+    else:
+        # byte level damage
+        chars = list(text)
+        for _ in range(rng.randint(1, 3)):
+            pos = rng.randrange(len(chars) + 1)
+            op = rng.random()
+            if op < 0.4 and chars:
+                del chars[min(pos, len(chars) - 1)]
+            elif op < 0.8:
+                chars.insert(pos, rng.choice('{}[]:,"\\ 0123456789-.eE\x01'))
+            elif chars:
+                chars[min(pos, len(chars) - 1)] = rng.choice('{}:,"x9')
+        return "".join(chars)
+    inner = text.strip()
+    if inner == "{}":
+        return "{" + member + "}"
+    return "{" + member + "," + inner[1:]
+
+
+# --- tests --------------------------------------------------------------------------------------------------------
+
+
+def check(texts):
+    taken = 0
+    for text, result in zip(texts, run(texts)):
+        root = strict_object(text)
+        if result == "reject":
+            continue
+        taken += 1
+        assert root is not None, f"reader took invalid JSON {text!r}"
+        want = model_calls(root)
+        if want is None:  # length overflow, undefined in C++
+            continue
+        assert result == want, f"{text!r}\n  reader:      {result}\n  ArduinoJson: {want}"
+    return taken
+
+
+def test_home_assistant_commands_take_the_fast_path():
+    rng = random.Random(1)
+    texts = [ha_command(rng) for _ in range(20000)]
+    taken = check(texts)
+    assert taken == len(texts)
+
+
+def test_everything_else_matches_or_falls_back():
+    rng = random.Random(2)
+    texts = [odd_command(rng) for _ in range(20000)]
+    texts += ["", "{", "}", "[]", "null", '"ON"', "{}", " { } ", "{}x", '{"state":"ON"}}', '{"state":"ON",}']
+    taken = check(texts)
+    # most of these have to go to ArduinoJson, but e.g. a duplicate "state" collapsing is fine either way
+    assert taken < len(texts) // 2
+
+
+def test_throughput():
+    out = subprocess.run([BINARY, "--bench", "1000000"], capture_output=True, text=True, check=True).stdout
+    print(out)
+    rate = float(out.split(":")[1].split()[0])
+    # the host is far faster than an ESP8266, this only catches the reader falling off a cliff
+    assert rate > 200000
@@ -0,0 +1,160 @@
+// LightState's traits cache against building the traits on every call, on the real LightTraits.
+//
+// A bulb has a main and an aux KaufRGBWWLight.  Their get_traits() builds a fresh LightTraits each time; before
+// the cache every LightCall asked for it twice (validate_() and set_color_mode_if_supported()).  Each simulated
+// call below does what those two do with the traits, once through the output and once through the cache, and the
+// answers have to agree.  The timings are printed, not checked.
+//
+// KaufRGBWWLight::get_traits() and LightState::get_traits() need ESPHome, so both are copied below
+// (KaufOutput::get_traits(), State::get_traits()) and have to be kept in step with them by hand.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "light_traits.h"
+
+using esphome::light::ColorCapability;
+using esphome::light::ColorMode;
+using esphome::light::ColorModeMask;
+using esphome::light::LightTraits;
+
+namespace {
+
+const uint32_t CALLS = 2000000;
+
+struct Output {
+  virtual ~Output() = default;
+  virtual LightTraits get_traits() = 0;
+};
+
+// KaufRGBWWLight::get_traits()
+struct KaufOutput : Output {
+  KaufOutput(bool aux) : aux(aux) {}
+  bool aux;
+  float min_mireds{153.0f};
+  float max_mireds{500.0f};
+
+  __attribute__((noinline)) LightTraits get_traits() override {
+    auto traits = LightTraits();
+    if (this->aux) {
+      traits.set_supported_color_modes({ColorMode::RGB_WHITE});
+    } else {
+      traits.set_min_mireds(this->min_mireds);
+      traits.set_max_mireds(this->max_mireds);
+      traits.set_supported_color_modes({ColorMode::RGB, ColorMode::COLOR_TEMPERATURE});
+    }
+    return traits;
+  }
+};
+
+// LightState::get_traits() and the part of setup() that fills the cache
+struct State {
+  explicit State(Output *output) : output(output) {}
+  Output *output;
+  LightTraits traits;
+  bool traits_cached{false};
+
+  void setup() {
+    this->traits = this->output->get_traits();
+    this->traits_cached = true;
+  }
+  const LightTraits &get_traits() {
+    if (!this->traits_cached)
+      this->traits = this->output->get_traits();
+    return this->traits;
+  }
+};
+
+const ColorMode REQUESTS[] = {ColorMode::RGB, ColorMode::COLOR_TEMPERATURE, ColorMode::RGB_WHITE, ColorMode::WHITE,
+                              ColorMode::UNKNOWN};
+
+// what validate_() and set_color_mode_if_supported() ask the traits, folded into one number to compare
+template<typename Traits> uint32_t call(Traits get_traits, ColorMode requested, float mireds) {
+  uint32_t answer = 0;
+  {
+    // set_color_mode_if_supported()
+    if (get_traits().supports_color_mode(requested))
+      answer |= 1;
+  }
+  {
+    // validate_()
+    const auto &traits = get_traits();
+    if (traits.supports_color_mode(requested))
+      answer |= 2;
+    const auto modes = traits.get_supported_color_modes();
+    answer |= uint32_t(modes.size()) << 2;
+    if (ColorModeMask::mask_contains(modes.get_mask(), requested))
+      answer |= 1 << 6;
+    if (traits.supports_color_capability(ColorCapability::COLOR_TEMPERATURE)) {
+      const float min = traits.get_min_mireds(), max = traits.get_max_mireds();
+      answer += uint32_t(mireds < min ? min : (mireds > max ? max : mireds)) << 8;
+    }
+  }
+  return answer;
+}
+
+int failures = 0;
+
+void check(bool ok, const char *what) {
+  std::printf("  %-56s %s\n", what, ok ? "ok" : "FAIL");
+  if (!ok)
+    failures++;
+}
+
+}  // namespace
+
+int main() {
+  KaufOutput main_output(false), aux_output(true);
+  State main_state(&main_output), aux_state(&aux_output);
+  // before setup() the state goes to the output
+  check(main_state.get_traits().get_max_mireds() == 500.0f, "traits before setup() come from the output");
+  main_state.setup();
+  aux_state.setup();
+
+  // the lights called through a volatile index so neither side is resolved at compile time
+  Output *outputs[] = {&main_output, &aux_output};
+  State *states[] = {&main_state, &aux_state};
+  volatile uint32_t salt = 0;
+
+  auto seconds_since = [](std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  // the lookups alone
+  uint32_t masks = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < CALLS; i++)
+    masks += outputs[(i + salt) & 1]->get_traits().get_supported_color_modes().get_mask();
+  const double lookup_direct = seconds_since(start);
+  start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < CALLS; i++)
+    masks -= states[(i + salt) & 1]->get_traits().get_supported_color_modes().get_mask();
+  const double lookup_cached = seconds_since(start);
+
+  // whole calls
+  uint32_t sum_direct = 0, sum_cached = 0;
+  start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < CALLS; i++) {
+    Output *output = outputs[(i + salt) & 1];
+    sum_direct += call([output]() { return output->get_traits(); }, REQUESTS[i % 5], 100.0f + float(i % 500));
+  }
+  const double direct = seconds_since(start);
+  start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < CALLS; i++) {
+    State *state = states[(i + salt) & 1];
+    sum_cached += call([state]() -> const LightTraits & { return state->get_traits(); }, REQUESTS[i % 5],
+                       100.0f + float(i % 500));
+  }
+  const double cached = seconds_since(start);
+
+  // host timings only, an ESP8266 pays more for the virtual call and the copy; nothing here is held to a bound
+  std::printf("traits, %u lookups / calls (main and aux light):\n", (unsigned) CALLS);
+  std::printf("  lookup from the output: %6.1f ns, cached: %6.1f ns\n", lookup_direct / CALLS * 1e9,
+              lookup_cached / CALLS * 1e9);
+  std::printf("  call from the output:   %6.1f ns, cached: %6.1f ns (2 lookups each)\n", direct / CALLS * 1e9,
+              cached / CALLS * 1e9);
+  check(masks == 0, "cached traits have the output's color modes");
+  check(sum_direct == sum_cached, "cached traits answer the same as the output's");
+  return failures == 0 ? 0 : 1;
+}
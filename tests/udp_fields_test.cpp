@@ -0,0 +1,349 @@
+// Load test of the kauf_udp_control field decoder (udp_fields.h) into a LightCall stand-in.
+//
+// Random commands are encoded the way kauf_udp_control.h lays them out and decoded again, and every setter call
+// has to carry the value that went in.  Packets cut short or with bytes left over, and random bytes under random
+// masks, have to be turned down without reading past the end (the sanitized build checks that).  Then a mix of
+// the usual commands is decoded and applied at full speed and the packet rate printed.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "udp_fields.h"
+
+using namespace esphome::kauf_udp_control;
+
+namespace {
+
+const uint32_t SAMPLES = 200000;
+const uint32_t LOAD_PACKETS = 5000000;
+
+enum class Mode : uint8_t {};
+
+// every setter's last value, and which were called
+struct Fields {
+  uint16_t called{0};
+  float units[8]{};
+  float color_temperature{0.0f};
+  bool state{false};
+  uint32_t transition{0};
+  uint32_t flash{0};
+  uint32_t effect{0};
+  uint8_t color_mode{0};
+  bool save{false};
+
+  bool operator==(const Fields &o) const {
+    return this->called == o.called && memcmp(this->units, o.units, sizeof(this->units)) == 0 &&
+           this->color_temperature == o.color_temperature && this->state == o.state &&
+           this->transition == o.transition && this->flash == o.flash && this->effect == o.effect &&
+           this->color_mode == o.color_mode && this->save == o.save;
+  }
+};
+
+struct RecordingCall {
+  Fields f;
+
+  void unit(uint8_t bit, float v) {
+    this->f.called |= 1 << bit;
+    this->f.units[bit] = v;
+  }
+  void set_brightness(float v) {
+    this->unit(0, v);
+    }
+  void set_color_brightness(float v) { this->unit(1, v);
+  }
+  void set_red(float v) {
+    this->unit(2, v);
+    }
+  void set_green(float v) { this->unit(3, v);
+  }
+  void set_blue(float v) {
+    this->unit(4, v);
+    }
+  void set_white(float v) { this->unit(5, v);
+  }
+  void set_cold_white(float v) {
+    this->unit(6, v);
+    }
+  void set_warm_white(float v) { this->unit(7, v);
+  }
+  void set_color_temperature(float v) {
+    this->f.called |= FIELD_COLOR_TEMPERATURE;
+    this->f.color_temperature = v;
+  }
+  void set_state(bool v) {
+    this->f.called |= FIELD_STATE;
+    this->f.state = v;
+  }
+  void set_transition_length(uint32_t v) {
+    this->f.called |= FIELD_TRANSITION;
+    this->f.transition = v;
+  }
+  void set_flash_length(uint32_t v) {
+    this->f.called |= FIELD_FLASH;
+    this->f.flash = v;
+  }
+  void set_effect(uint32_t v) {
+    this->f.called |= FIELD_EFFECT;
+    this->f.effect = v;
+  }
+  void set_color_mode(Mode v) {
+    this->f.called |= FIELD_COLOR_MODE;
+    this->f.color_mode = uint8_t(v);
+  }
+  void set_save(bool v) { this->f.save = v; }
+};
+
+// LightCall's setters at their cheapest, storing the value and its flag
+struct ApplyCall {
+  float units[8]{};
+  float color_temperature{0.0f};
+  uint32_t lengths{0};
+  uint32_t effect{0};
+  uint16_t flags{0};
+  bool state{false};
+  bool save{false};
+
+  void set_brightness(float v) {
+    this->units[0] = v;
+    this->flags |= 1 << 0;
+  }
+  void set_color_brightness(float v) {
+    this->units[1] = v;
+    this->flags |= 1 << 1;
+  }
+  void set_red(float v) {
+    this->units[2] = v;
+    this->flags |= 1 << 2;
+  }
+  void set_green(float v) {
+    this->units[3] = v;
+    this->flags |= 1 << 3;
+  }
+  void set_blue(float v) {
+    this->units[4] = v;
+    this->flags |= 1 << 4;
+  }
+  void set_white(float v) {
+    this->units[5] = v;
+    this->flags |= 1 << 5;
+  }
+  void set_cold_white(float v) {
+    this->units[6] = v;
+    this->flags |= 1 << 6;
+  }
+  void set_warm_white(float v) {
+    this->units[7] = v;
+    this->flags |= 1 << 7;
+  }
+  void set_color_temperature(float v) {
+    this->color_temperature = v;
+    this->flags |= FIELD_COLOR_TEMPERATURE;
+  }
+  void set_state(bool v) {
+    this->state = v;
+    this->flags |= FIELD_STATE;
+  }
+  void set_transition_length(uint32_t v) {
+    this->lengths += v;
+    this->flags |= FIELD_TRANSITION;
+  }
+  void set_flash_length(uint32_t v) {
+    this->lengths += v;
+    this->flags |= FIELD_FLASH;
+  }
+  void set_effect(uint32_t v) {
+    this->effect = v;
+    this->flags |= FIELD_EFFECT;
+  }
+  void set_color_mode(Mode v) {
+    this->effect += uint8_t(v);
+    this->flags |= FIELD_COLOR_MODE;
+  }
+  void set_save(bool v) { this->save = v; }
+};
+
+uint32_t rng_state = 88172645u;
+uint32_t next_random() {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+void put_u16(std::vector<uint8_t> &out, uint16_t v) {
+  out.push_back(uint8_t(v));
+  out.push_back(uint8_t(v >> 8));
+}
+void put_u32(std::vector<uint8_t> &out, uint32_t v) {
+  put_u16(out, uint16_t(v));
+  put_u16(out, uint16_t(v >> 16));
+}
+
+// a random command laid out per kauf_udp_control.h, with the setter calls it has to make
+std::vector<uint8_t> random_command(uint16_t mask, Fields &want) {
+  std::vector<uint8_t> out;
+  want = Fields{};
+  for (uint8_t bit = 0; bit < 8; bit++) {
+    if (mask & (1 << bit)) {
+      const uint8_t v = uint8_t(next_random());
+      out.push_back(v);
+      want.called |= 1 << bit;
+      want.units[bit] = v / 255.0f;
+    }
+  }
+  if (mask & FIELD_COLOR_TEMPERATURE) {
+    const uint16_t v = uint16_t(next_random());
+    put_u16(out, v);
+    want.called |= FIELD_COLOR_TEMPERATURE;
+    want.color_temperature = float(v);
+  }
+  if (mask & FIELD_STATE) {
+    const uint8_t v = next_random() % 3 == 0 ? 0 : uint8_t(next_random());
+    out.push_back(v);
+    want.called |= FIELD_STATE;
+    want.state = v != 0;
+  }
+  if (mask & FIELD_TRANSITION) {
+    const uint32_t v = next_random();
+    put_u32(out, v);
+    want.called |= FIELD_TRANSITION;
+    want.transition = v;
+  }
+  if (mask & FIELD_FLASH) {
+    const uint32_t v = next_random();
+    put_u32(out, v);
+    want.called |= FIELD_FLASH;
+    want.flash = v;
+  }
+  if (mask & FIELD_EFFECT) {
+    const uint16_t v = uint16_t(next_random());
+    put_u16(out, v);
+    want.called |= FIELD_EFFECT;
+    want.effect = v;
+  }
+  if (mask & FIELD_COLOR_MODE) {
+    const uint8_t v = uint8_t(next_random());
+    out.push_back(v);
+    want.called |= FIELD_COLOR_MODE;
+    want.color_mode = v;
+  }
+  want.save = mask & FIELD_SAVE;
+  return out;
+}
+
+size_t fields_size(uint16_t mask) {
+  size_t size = __builtin_popcount(mask & 0xFF);
+  if (mask & FIELD_COLOR_TEMPERATURE)
+    size += 2;
+  if (mask & FIELD_STATE)
+    size += 1;
+  if (mask & FIELD_TRANSITION)
+    size += 4;
+  if (mask & FIELD_FLASH)
+    size += 4;
+  if (mask & FIELD_EFFECT)
+    size += 2;
+  if (mask & FIELD_COLOR_MODE)
+    size += 1;
+  return size;
+}
+
+// decode from a heap copy of exactly len bytes, so a read past the end is caught by the sanitizer
+bool decode_exact(const uint8_t *data, size_t len, uint16_t mask, RecordingCall &call) {
+  uint8_t *copy = static_cast<uint8_t *>(malloc(len == 0 ? 1 : len));
+  if (len != 0)
+    memcpy(copy, data, len);
+  const bool ok = decode_fields<Mode>(copy, len, mask, call);
+  free(copy);
+  return ok;
+}
+
+int failures = 0;
+
+void check(bool ok, const char *what) {
+  std::printf("  %-62s %s\n", what, ok ? "ok" : "FAIL");
+  if (!ok)
+    failures++;
+}
+
+}  // namespace
+
+int main() {
+  std::printf("kauf_udp_control field decoder:\n");
+
+  uint32_t wrong = 0, short_taken = 0, long_taken = 0;
+  for (uint32_t i = 0; i < SAMPLES; i++) {
+    const uint16_t mask = uint16_t(next_random());
+    Fields want;
+    std::vector<uint8_t> packet = random_command(mask, want);
+
+    RecordingCall call;
+    if (!decode_exact(packet.data(), packet.size(), mask, call) || !(call.f == want))
+      wrong++;
+
+    if (!packet.empty()) {
+      RecordingCall cut;
+      if (decode_exact(packet.data(), next_random() % packet.size(), mask, cut))
+        short_taken++;
+    }
+    packet.push_back(uint8_t(next_random()));
+    RecordingCall extra;
+    if (decode_exact(packet.data(), packet.size(), mask, extra))
+      long_taken++;
+  }
+  std::printf("  %u random commands: %u decoded wrong, %u cut short taken, %u with leftovers taken\n",
+              (unsigned) SAMPLES, (unsigned) wrong, (unsigned) short_taken, (unsigned) long_taken);
+  check(wrong == 0, "every field reaches its setter with the value sent");
+  check(short_taken == 0 && long_taken == 0, "packets cut short or with leftovers are turned down");
+
+  // random bytes under random masks: taken exactly when the length is the mask's
+  uint32_t mismatched = 0;
+  uint8_t noise[64];
+  for (uint32_t i = 0; i < SAMPLES; i++) {
+    const uint16_t mask = uint16_t(next_random());
+    const size_t len = next_random() % 2 == 0 ? fields_size(mask) : next_random() % (sizeof(noise) + 1);
+    for (size_t n = 0; n < len; n++)
+      noise[n] = uint8_t(next_random());
+    RecordingCall call;
+    if (decode_exact(noise, len, mask, call) != (len == fields_size(mask)))
+      mismatched++;
+  }
+  check(mismatched == 0, "random bytes are taken exactly when the length fits the mask");
+
+  // the usual commands: brightness + state + transition, RGB, color temperature, effect, off
+  const uint16_t MASKS[] = {
+      FIELD_BRIGHTNESS | FIELD_STATE | FIELD_TRANSITION,
+      FIELD_COLOR_BRIGHTNESS | FIELD_RED | FIELD_GREEN | FIELD_BLUE | FIELD_STATE | FIELD_COLOR_MODE,
+      FIELD_BRIGHTNESS | FIELD_COLOR_TEMPERATURE | FIELD_STATE | FIELD_COLOR_MODE | FIELD_TRANSITION,
+      FIELD_EFFECT | FIELD_STATE,
+      FIELD_STATE | FIELD_TRANSITION | FIELD_SAVE,
+  };
+  constexpr uint32_t kinds = sizeof(MASKS) / sizeof(MASKS[0]);
+  std::vector<uint8_t> packets[kinds];
+  for (uint32_t k = 0; k < kinds; k++) {
+    Fields want;
+    packets[k] = random_command(MASKS[k], want);
+  }
+
+  ApplyCall call;
+  uint32_t rejected = 0;
+  size_t bytes = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < LOAD_PACKETS; i++) {
+    const uint32_t k = i % kinds;
+    if (!decode_fields<Mode>(packets[k].data(), packets[k].size(), MASKS[k], call))
+      rejected++;
+    bytes += packets[k].size();
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::printf("  load: %u packets in %.3f s, %.1f ns per packet, %.0f packets/s (%zu field bytes, flags %04x)\n",
+              (unsigned) LOAD_PACKETS, seconds, seconds / LOAD_PACKETS * 1e9, LOAD_PACKETS / seconds, bytes,
+              (unsigned) call.flags);
+  check(rejected == 0, "the usual commands all decode under load");
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+// ConstantLightCall's validation memo (validation_memo.h) on the real LightColorValues.
+//
+// Two constant actions (a warm white and a red button) take turns on one light, each with its own memo, and each
+// trigger's target has to match a fresh validation.  Any change of remote values, effect or default transition has
+// to validate again.  Then the triggers are timed with and without the memo.
+//
+// LightCall::validate_() needs a LightState, so validate() below stands in for it: unset fields from the remote
+// values, set ones clamped, color normalized.  The real one also resolves color modes against the traits and logs,
+// so the saving printed here is a lower bound.  Host timings are printed, not checked.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "validation_memo.h"
+
+using esphome::light::ColorMode;
+using esphome::light::LightColorValues;
+using esphome::light::ValidationInput;
+using esphome::light::ValidationMemo;
+
+namespace {
+
+const uint32_t TRIGGERS = 2000000;
+
+// a constant call's fields
+struct Action {
+  ColorMode mode;
+  float brightness;
+  float red, green, blue;
+  float color_temperature;
+};
+
+const Action WARM{ColorMode::COLOR_TEMPERATURE, 0.4f, 0.0f, 0.0f, 0.0f, 370.0f};
+const Action RED{ColorMode::RGB, 1.0f, 1.0f, 0.1f, 0.0f, 0.0f};
+
+struct Validated {
+  LightColorValues target;
+};
+
+struct Light {
+  LightColorValues remote_values;
+  uint32_t effect{0};
+  uint32_t default_transition{1000};
+
+  ValidationInput input() const { return {this->remote_values, this->effect, this->default_transition}; }
+};
+
+LightColorValues validate(const Light &light, const Action &action) {
+  LightColorValues v = light.remote_values;
+  v.set_color_mode(action.mode);
+  v.set_state(1.0f);
+  v.set_brightness(action.brightness);
+  if (action.mode == ColorMode::RGB) {
+    v.set_color_brightness(1.0f);
+    v.set_red(action.red);
+    v.set_green(action.green);
+    v.set_blue(action.blue);
+    v.normalize_color();
+  } else {
+    v.set_color_temperature(action.color_temperature);
+  }
+  if (light.effect != 0 && light.default_transition == 0)
+    v.set_brightness(1.0f);
+  return v;
+}
+
+struct Trigger {
+  const Action &action;
+  ValidationMemo<Validated> memo{};
+  uint32_t reused{0};
+
+  const LightColorValues &perform(Light &light) {
+    bool hit;
+    const Validated &validated = this->memo.get(
+        light.input(), [this, &light](Validated &out) { out.target = validate(light, this->action); }, hit);
+    if (hit)
+      this->reused++;
+    light.remote_values = validated.target;
+    return validated.target;
+  }
+};
+
+int failures = 0;
+
+void check(bool ok, const char *what) {
+  std::printf("  %-62s %s\n", what, ok ? "ok" : "FAIL");
+  if (!ok)
+    failures++;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+int main() {
+  std::printf("constant call validation memo:\n");
+
+  {
+    Light light;
+    Trigger warm{WARM}, red{RED};
+    bool same = true;
+    for (uint32_t i = 0; i < 1000; i++) {
+      Trigger &t = i % 2 == 0 ? warm : red;
+      const LightColorValues fresh = validate(light, t.action);
+      same &= t.perform(light) == fresh;
+    }
+    check(same, "every trigger gets the target a fresh validation gives");
+    // each button's first two triggers see new remote values, the rest see the other button's target
+    check(warm.reused == 498 && red.reused == 498, "buttons taking turns reuse their validation");
+
+    // one more round to be on a hit, then each input change on its own
+    bool missed = true;
+    auto miss_after = [&](auto change) {
+      warm.perform(light);
+      red.perform(light);
+      const uint32_t before = warm.reused;
+      change();
+      const LightColorValues fresh = validate(light, WARM);
+      same &= warm.perform(light) == fresh;
+      missed &= warm.reused == before;
+    };
+    miss_after([&] { light.remote_values.set_brightness(0.5f); });
+    miss_after([&] { light.remote_values.set_warm_white(0.25f); });
+    miss_after([&] { light.remote_values.set_color_mode(ColorMode::RGB_WHITE); });
+    miss_after([&] { light.effect = 3; });
+    miss_after([&] { light.default_transition = 0; });
+    check(missed && same, "remote values, effect or transition changes validate again");
+  }
+
+  Light light;
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < TRIGGERS; i++)
+    light.remote_values = validate(light, i % 2 == 0 ? WARM : RED);
+  const double always = seconds_since(start);
+  const LightColorValues always_last = light.remote_values;
+
+  light = Light{};
+  Trigger warm{WARM}, red{RED};
+  start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < TRIGGERS; i++)
+    (i % 2 == 0 ? warm : red).perform(light);
+  const double memo = seconds_since(start);
+
+  std::printf("  %u triggers, two buttons taking turns:\n", (unsigned) TRIGGERS);
+  std::printf("    validate every trigger: %6.1f ns per trigger\n", always / TRIGGERS * 1e9);
+  std::printf("    memo:                   %6.1f ns per trigger, %u of %u reused\n", memo / TRIGGERS * 1e9,
+              (unsigned) (warm.reused + red.reused), (unsigned) TRIGGERS);
+  check(light.remote_values == always_last, "both end on the same values");
+  return failures == 0 ? 0 : 1;
+}